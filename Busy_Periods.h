@@ -0,0 +1,321 @@
+// Busy-period decomposition shared by the scheduling programs
+//
+// Every policy of these programs is work-conserving: the CPU only idles while no unfinished process has arrived.
+// The schedule therefore splits into busy periods that do not influence each other. find_busy_periods finds them with
+// one scan over the processes in arrival order, and run_busy_periods simulates them with the program's own engine in
+// a pool of worker processes and stitches the results back into the process array and the Gantt chart, so the result
+// is the one of a single sequential run.
+//
+// Before including this header, the including file provides MAX_PROCESS, the process array processes, the process
+// count n, the Gantt chart array gantt_chart with its entry count I, and defines:
+//   BUSY_PERIODS_ENGINE()        runs the engine on processes[0] to processes[n - 1], with an empty Gantt chart
+// and optionally:
+//   BUSY_PERIODS_SORTED          the engine sorts the processes by arrival time, so they are sorted before the split
+//   BUSY_PERIODS_GANTT_INDICES   the Gantt chart holds indices into the process array instead of process IDs
+//   BUSY_PERIODS_NO_GANTT        the program has no Gantt chart array
+// Telemetry, statistics and checkpoints are recorded by the engine, so they must be off in the workers.
+
+#ifndef BUSY_PERIODS_H
+#define BUSY_PERIODS_H
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define MAX_BUSY_WORKERS 64  // Maximum number of worker processes simulating busy periods
+
+// Structure of the message a worker sends back for every busy period, followed by the processes of the period in
+// the order of busy_members and by its Gantt chart slots
+typedef struct
+{
+    int period;     // Index of the busy period
+    int slots;      // Number of Gantt chart slots following the processes
+} Busy_Result;
+
+static Process busy_processes[MAX_PROCESS];     // The processes before the split, every period is copied from them
+static int busy_members[MAX_PROCESS];           // Indices of the processes of every busy period, period by period in time order
+static int busy_start[MAX_PROCESS + 1];         // Period p holds busy_members[busy_start[p]] to busy_members[busy_start[p + 1] - 1]
+static int busy_count;                          // Number of busy periods
+#ifndef BUSY_PERIODS_NO_GANTT
+static void *busy_slots[MAX_PROCESS];           // Gantt chart slots received for every period
+static int busy_slot_count[MAX_PROCESS];        // Number of slots received for every period
+#endif
+
+// Function to split the processes into busy periods with one scan over them in arrival order
+// A period ends when the next process arrives after all the work that arrived before it is done
+static void find_busy_periods()
+{
+    int order[MAX_PROCESS];
+
+#ifdef BUSY_PERIODS_SORTED
+    // Sort the processes by arrival time like the engine would, keeping the order of equal arrivals
+    for (int i = 1; i < n; i++)
+    {
+        Process process = processes[i];
+        int j = i;
+
+        while (j > 0 && processes[j - 1].arrival_time > process.arrival_time)
+        {
+            processes[j] = processes[j - 1];
+            j--;
+        }
+        processes[j] = process;
+    }
+#endif
+
+    // Order the indices by arrival time using insertion sort, keeping the order of equal arrivals
+    for (int i = 0; i < n; i++)
+    {
+        int j = i;
+
+        while (j > 0 && processes[order[j - 1]].arrival_time > processes[i].arrival_time)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // The engines start the clock at 0, so the first period starts there or at the first arrival
+    long long end = 0;
+
+    busy_count = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int i = order[k];
+
+        if (k == 0 || processes[i].arrival_time > end)
+            busy_start[busy_count++] = k;
+
+        if (end < processes[i].arrival_time)
+            end = processes[i].arrival_time;
+        end += processes[i].burst_time;
+    }
+    busy_start[busy_count] = n;
+
+    // Keep the processes of every period in their order in the array, which the engines use to break ties
+    for (int p = 0; p < busy_count; p++)
+    {
+        for (int k = busy_start[p] + 1; k < busy_start[p + 1]; k++)
+        {
+            int i = order[k], j = k;
+
+            while (j > busy_start[p] && order[j - 1] > i)
+            {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+        busy_members[k] = order[k];
+}
+
+// Function to read exactly size bytes from a pipe, returns 0 on success and -1 if it ends first
+static int read_busy_result(int fd, void *buffer, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t got = read(fd, buffer, size);
+
+        if (got <= 0)
+            return -1;
+
+        buffer = (char *)buffer + got;
+        size -= got;
+    }
+
+    return 0;
+}
+
+// Function to simulate one busy period in a worker and send its processes and Gantt chart back through the pipe
+static int send_busy_period(int fd, int period)
+{
+    Busy_Result result;
+
+    n = busy_start[period + 1] - busy_start[period];
+    for (int j = 0; j < n; j++)
+        processes[j] = busy_processes[busy_members[busy_start[period] + j]];
+
+#ifndef BUSY_PERIODS_NO_GANTT
+    I = 0;
+#endif
+    BUSY_PERIODS_ENGINE();
+
+    result.period = period;
+#ifdef BUSY_PERIODS_NO_GANTT
+    result.slots = 0;
+#else
+    result.slots = I;
+#endif
+
+    if (write(fd, &result, sizeof(result)) != (ssize_t)sizeof(result)
+        || write(fd, processes, n * sizeof(Process)) != (ssize_t)(n * sizeof(Process)))
+        return -1;
+
+#ifndef BUSY_PERIODS_NO_GANTT
+    if (write(fd, gantt_chart, I * sizeof(gantt_chart[0])) != (ssize_t)(I * sizeof(gantt_chart[0])))
+        return -1;
+#endif
+
+    return 0;
+}
+
+// Function to receive the results of one busy period from a worker, storing its processes at their places in the array
+static int receive_busy_period(int fd)
+{
+    Busy_Result result;
+    Process received[MAX_PROCESS];
+
+    if (read_busy_result(fd, &result, sizeof(result)) == -1 || result.period < 0 || result.period >= busy_count)
+        return -1;
+
+    int first = busy_start[result.period], count = busy_start[result.period + 1] - first;
+
+    if (read_busy_result(fd, received, count * sizeof(Process)) == -1)
+        return -1;
+
+    for (int j = 0; j < count; j++)
+        processes[busy_members[first + j]] = received[j];
+
+#ifndef BUSY_PERIODS_NO_GANTT
+    if (result.slots < 0 || result.slots > (int)(sizeof(gantt_chart) / sizeof(gantt_chart[0])))
+        return -1;
+
+    busy_slots[result.period] = malloc(result.slots * sizeof(gantt_chart[0]) + 1);
+    busy_slot_count[result.period] = result.slots;
+
+    if (busy_slots[result.period] == NULL
+        || read_busy_result(fd, busy_slots[result.period], result.slots * sizeof(gantt_chart[0])) == -1)
+        return -1;
+#endif
+
+    return 0;
+}
+
+// Function to stitch the Gantt charts of the busy periods together in time order, as far as the chart has room
+// Every period after the first starts with the idle slot up to its first arrival, so the slots simply follow each other
+static void stitch_busy_periods()
+{
+#ifndef BUSY_PERIODS_NO_GANTT
+    int capacity = (int)(sizeof(gantt_chart) / sizeof(gantt_chart[0]));
+
+    I = 0;
+    for (int p = 0; p < busy_count; p++)
+    {
+        int count = (busy_slot_count[p] < capacity - I) ? busy_slot_count[p] : capacity - I;
+
+        memcpy(&gantt_chart[I], busy_slots[p], count * sizeof(gantt_chart[0]));
+
+#ifdef BUSY_PERIODS_GANTT_INDICES
+        // The worker recorded indices into its own copy of the period, map them back to the whole array
+        for (int k = I; k < I + count; k++)
+            gantt_chart[k] = busy_members[busy_start[p] + gantt_chart[k]];
+#endif
+
+        I += count;
+    }
+#endif
+}
+
+// Function to stop the first started workers after a failed start, closing their pipes and reaping them
+static void stop_busy_workers(const int *pipes, const pid_t *pids, int started)
+{
+    for (int w = 0; w < started; w++)
+    {
+        close(pipes[w]);
+        kill(pids[w], SIGKILL);
+        waitpid(pids[w], NULL, 0);
+    }
+}
+
+// Function to simulate the busy periods in parallel worker processes and stitch their results together
+// Every workers-th period goes to the same worker, so the periods spread evenly over the workers
+// Returns the number of busy periods, -1 if a worker could not be started or its results were lost
+static int run_busy_periods(int workers)
+{
+    int pipes[MAX_BUSY_WORKERS];
+    pid_t pids[MAX_BUSY_WORKERS];
+    int total = n, received = 0, failed = 0;
+
+    find_busy_periods();
+
+    for (int i = 0; i < n; i++)
+        busy_processes[i] = processes[i];
+
+    if (workers > busy_count)
+        workers = busy_count;
+
+    fflush(stdout);     // Keep buffered output out of the workers
+
+    for (int w = 0; w < workers; w++)
+    {
+        int fds[2];
+
+        if (pipe(fds) == -1)
+        {
+            stop_busy_workers(pipes, pids, w);
+            return -1;
+        }
+
+        if ((pids[w] = fork()) == -1)
+        {
+            close(fds[0]);
+            close(fds[1]);
+            stop_busy_workers(pipes, pids, w);
+            return -1;
+        }
+
+        if (pids[w] == 0)
+        {
+            close(fds[0]);
+
+            for (int p = w; p < busy_count; p += workers)
+            {
+                if (send_busy_period(fds[1], p) == -1)
+                    _exit(1);
+            }
+
+            _exit(0);
+        }
+
+        close(fds[1]);
+        pipes[w] = fds[0];
+    }
+
+    // Merge the results of the workers
+    for (int w = 0; w < workers; w++)
+    {
+        for (int p = w; p < busy_count && !failed; p += workers)
+        {
+            if (receive_busy_period(pipes[w]) == -1)
+                failed = 1;
+            else
+                received++;
+        }
+
+        close(pipes[w]);
+        waitpid(pids[w], NULL, 0);
+    }
+
+    n = total;
+
+    if (!failed && received == busy_count)
+        stitch_busy_periods();
+
+#ifndef BUSY_PERIODS_NO_GANTT
+    for (int p = 0; p < busy_count; p++)
+    {
+        free(busy_slots[p]);
+        busy_slots[p] = NULL;
+    }
+#endif
+
+    return (!failed && received == busy_count) ? busy_count : -1;
+}
+
+#endif
@@ -0,0 +1,148 @@
+// Background writer of engine checkpoints shared by SRTF_in_C.c, Priority_Preemptive_in_C.c and Round_Robin_in_C.c
+//
+// Before including this header, define:
+//   CHECKPOINT_FILE            file holding the latest checkpoint
+//   CHECKPOINT_SNAPSHOT_SIZE   largest checkpoint in bytes
+// The engine calls the program's save_checkpoint every CHECKPOINT_INTERVAL steps. save_checkpoint asks
+// begin_checkpoint for a buffer, which is only handed out once checkpoint_period seconds have passed since the last
+// checkpoint (or since the first call), copies the engine state into it and passes it on with commit_checkpoint.
+// A writer thread writes the buffer to a temporary file and renames it over CHECKPOINT_FILE, while the engine keeps
+// running and fills the other of the two buffers next time, so the scheduling loop never waits for the file system.
+// finish_checkpoints waits for the writer and removes the checkpoint once the run is complete. Clearing checkpointing
+// turns both off, for runs that are never resumed.
+
+#ifndef CHECKPOINT_WRITER_H
+#define CHECKPOINT_WRITER_H
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+static int checkpointing = 1;           // Cleared when the engine runs workloads that are never resumed, nothing is then written or removed
+static double checkpoint_period = 1.0;  // Seconds between two checkpoints, set by --checkpoint-interval, 0 for every call
+
+static unsigned char checkpoint_buffers[2][CHECKPOINT_SNAPSHOT_SIZE];  // The engine fills one while the writer writes the other
+static size_t checkpoint_lengths[2];    // Bytes used in each buffer
+static int checkpoint_pending = -1;     // Buffer waiting for the writer, -1 if none
+static int checkpoint_writing = -1;     // Buffer being written, -1 if none
+static int checkpoint_filling = -1;     // Buffer being filled by the engine, -1 if none
+static int checkpoint_stopping = 0;     // Set when the writer should exit once nothing is pending
+static int checkpoint_started = 0;      // Set once the writer thread is running
+static double checkpoint_last = -1;     // Monotonic time of the last checkpoint, -1 before the first call
+static pthread_t checkpoint_thread;
+static pthread_mutex_t checkpoint_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t checkpoint_ready = PTHREAD_COND_INITIALIZER;
+
+// Function to write checkpoints handed over by the engine until it stops
+// Each one goes to a temporary file first and is then renamed, so an interrupted write never damages the previous checkpoint
+static void *checkpoint_writer(void *unused)
+{
+    (void)unused;
+
+    pthread_mutex_lock(&checkpoint_lock);
+
+    while (1)
+    {
+        while (checkpoint_pending == -1 && !checkpoint_stopping)
+            pthread_cond_wait(&checkpoint_ready, &checkpoint_lock);
+
+        if (checkpoint_pending == -1)
+            break;
+
+        checkpoint_writing = checkpoint_pending;
+        checkpoint_pending = -1;
+        pthread_mutex_unlock(&checkpoint_lock);
+
+        FILE *file = fopen(CHECKPOINT_FILE ".tmp", "wb");
+
+        if (file != NULL)
+        {
+            int written = fwrite(checkpoint_buffers[checkpoint_writing], 1, checkpoint_lengths[checkpoint_writing], file)
+                == checkpoint_lengths[checkpoint_writing];
+
+            if (fclose(file) == 0 && written)
+                rename(CHECKPOINT_FILE ".tmp", CHECKPOINT_FILE);
+        }
+
+        pthread_mutex_lock(&checkpoint_lock);
+        checkpoint_writing = -1;
+    }
+
+    pthread_mutex_unlock(&checkpoint_lock);
+    return NULL;
+}
+
+// Function to get a buffer for the next checkpoint, returns NULL if the last checkpoint is too recent
+static unsigned char *begin_checkpoint()
+{
+    struct timespec now;
+
+    if (!checkpointing)
+        return NULL;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double seconds = now.tv_sec + now.tv_nsec / 1e9;
+
+    // The clock starts at the first call, so a run shorter than checkpoint_period never writes a checkpoint
+    if (checkpoint_last < 0)
+        checkpoint_last = seconds;
+    if (seconds - checkpoint_last < checkpoint_period)
+        return NULL;
+    checkpoint_last = seconds;
+
+    // Take the buffer the writer is not using, replacing a pending checkpoint that has not been picked up yet
+    pthread_mutex_lock(&checkpoint_lock);
+    checkpoint_filling = (checkpoint_writing == 0) ? 1 : 0;
+    if (checkpoint_pending == checkpoint_filling)
+        checkpoint_pending = -1;
+    pthread_mutex_unlock(&checkpoint_lock);
+
+    return checkpoint_buffers[checkpoint_filling];
+}
+
+// Function to hand the filled buffer of length bytes to the writer, starting the writer on the first checkpoint
+static void commit_checkpoint(size_t length)
+{
+    if (!checkpoint_started)
+        checkpoint_started = (pthread_create(&checkpoint_thread, NULL, checkpoint_writer, NULL) == 0);
+
+    pthread_mutex_lock(&checkpoint_lock);
+    checkpoint_lengths[checkpoint_filling] = length;
+    checkpoint_pending = checkpoint_filling;
+    checkpoint_filling = -1;
+    pthread_cond_signal(&checkpoint_ready);
+    pthread_mutex_unlock(&checkpoint_lock);
+
+    // Without a writer thread, write the checkpoint in place
+    if (!checkpoint_started)
+    {
+        checkpoint_stopping = 1;
+        checkpoint_writer(NULL);
+        checkpoint_stopping = 0;
+    }
+}
+
+// Function to wait for the writer and remove the checkpoint, since the run it belongs to is complete
+static void finish_checkpoints()
+{
+    if (!checkpointing)
+        return;
+
+    if (checkpoint_started)
+    {
+        pthread_mutex_lock(&checkpoint_lock);
+        checkpoint_stopping = 1;
+        pthread_cond_signal(&checkpoint_ready);
+        pthread_mutex_unlock(&checkpoint_lock);
+
+        pthread_join(checkpoint_thread, NULL);
+        checkpoint_started = 0;
+        checkpoint_stopping = 0;
+    }
+
+    checkpoint_pending = -1;
+    checkpoint_last = -1;
+    remove(CHECKPOINT_FILE);
+}
+
+#endif
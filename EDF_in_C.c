@@ -0,0 +1,633 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes entered interactively, a workload file may hold any number
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int relative_deadline; // Deadline of the process, counted from its arrival
+    int completion_time;   // Time at which the process finishes execution
+    int remaining_time;    // Remaining time for the process to execute
+} Process;
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Function to derive the absolute deadline of a process from its arrival time
+static inline int deadline(const Process *p)
+{
+    return p->arrival_time + p->relative_deadline;
+}
+
+// Function to derive the lateness of a process from its completion time, negative when it finishes early
+static inline int lateness(const Process *p)
+{
+    return p->completion_time - deadline(p);
+}
+
+// Function to derive the tardiness of a process: its lateness, or 0 when the deadline is met
+static inline int tardiness(const Process *p)
+{
+    return (lateness(p) > 0) ? lateness(p) : 0;
+}
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G *gantt_chart; // Array of Gantt chart, every process adds at most one run, one preemption and one idle slot
+Process *processes; // Array of processes, allocated for MAX_PROCESS or for the processes of the workload file
+int I = 0;  // Gantt chart tracker index
+int n;  // Number of processes
+int preemptive = 1;  // Set to 0 to run every dispatched process to completion
+
+// Reader of the --workload files, the third column holds the relative deadline of each process
+#define WORKLOAD_PRIORITY_FIELD relative_deadline
+#include "Workload_Reader.h"
+
+int *heap;              // Ready queue as a binary min-heap of process indices, ordered by absolute deadline
+int heap_size = 0;      // Number of processes in the ready queue
+
+// Function to allocate the processes, the Gantt chart and the ready queue for count processes
+// Returns -1 if the memory is not available
+int allocate_processes(int count)
+{
+    processes = malloc(count * sizeof(Process));
+    gantt_chart = malloc(3 * (size_t)count * sizeof(G));
+    heap = malloc(count * sizeof(int));
+
+    return (processes == NULL || gantt_chart == NULL || heap == NULL) ? -1 : 0;
+}
+
+// Function to read a workload file of any size, allocating the arrays for its processes
+// Returns the number of processes, -1 on error
+int load_large_workload(const char *path)
+{
+    long long count = count_workload_records(path);
+
+    if (count < 1 || count > __INT_MAX__ || allocate_processes((int)count) == -1)
+        return -1;
+
+    n = read_workload(path, (int)count, store_process);
+    return n;
+}
+
+// Function to compare two processes for qsort by arrival time, equal arrivals keep their input order
+int compare_arrival(const void *a, const void *b)
+{
+    const Process *x = a, *y = b;
+
+    if (x->arrival_time != y->arrival_time)
+        return (x->arrival_time > y->arrival_time) - (x->arrival_time < y->arrival_time);
+
+    return (x->process_id > y->process_id) - (x->process_id < y->process_id);
+}
+
+// Function to compare two integers for qsort in increasing order
+int compare_int(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Function to check whether process a must run before process b: earlier deadline first, then earlier arrival
+int runs_before(int a, int b)
+{
+    if (deadline(&processes[a]) != deadline(&processes[b]))
+        return deadline(&processes[a]) < deadline(&processes[b]);
+
+    return processes[a].arrival_time < processes[b].arrival_time;
+}
+
+// Function to add a process to the ready queue
+void heap_push(int process)
+{
+    int i = heap_size++;
+
+    // Move the new process up until its parent runs before it
+    while (i > 0 && runs_before(process, heap[(i - 1) / 2]))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    heap[i] = process;
+}
+
+// Function to remove and return the process with the earliest deadline from the ready queue
+int heap_pop()
+{
+    int top = heap[0], last = heap[--heap_size], i = 0;
+
+    // Move the last process down from the root until both children run after it
+    while (2 * i + 1 < heap_size)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < heap_size && runs_before(heap[child + 1], heap[child]))
+            child++;
+
+        if (!runs_before(heap[child], last))
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = last;
+    return top;
+}
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to perform Earliest Deadline First Scheduling and calculate the completion time, turnaround time, waiting time, lateness and tardiness
+// The engine is event-driven: the clock jumps from one arrival or completion to the next instead of advancing one unit at a time
+void edf_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+
+    // Initialize remaining time for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+    }
+
+    // Sort the processes based on their arrival time, in O(n log n) so that large workloads stay fast
+    qsort(processes, n, sizeof(Process), compare_arrival);
+
+    while (completed_processes < n)
+    {
+        // Move every process that has arrived into the ready queue
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+            heap_push(next_arrival++);
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (heap_size == 0)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            add_gantt_slot(-1, current_time);
+            continue;
+        }
+
+        int next_process = heap_pop();
+        int run_until = current_time + processes[next_process].remaining_time;
+
+        // A pre-emptive run stops at the next arrival, which may have an earlier deadline
+        if (preemptive && next_arrival < n && processes[next_arrival].arrival_time < run_until)
+            run_until = processes[next_arrival].arrival_time;
+
+        processes[next_process].remaining_time -= run_until - current_time;
+        current_time = run_until;
+        add_gantt_slot(processes[next_process].process_id, current_time);
+
+        if (processes[next_process].remaining_time > 0)
+        {
+            heap_push(next_process);    // Put the pre-empted process back into the ready queue
+            continue;
+        }
+
+        // Update the completion time for the process, its lateness and tardiness follow from it
+        processes[next_process].completion_time = current_time;
+
+        completed_processes++;   // Increment the number of completed processes
+    }
+}
+
+// Segment tree of the processor demand test over the distinct deadlines in increasing order
+// Leaf p holds the demand due by deadline p minus that deadline, for the processes added so far
+int deadline_count;             // Number of distinct deadlines, the leaves of the tree
+int *deadline_values;           // Distinct deadlines in increasing order
+long long *slack_max;           // Largest leaf value in the subtree, including the pending additions of the node
+long long *slack_add;           // Addition pending for the whole subtree of the node
+int *slack_argmax;              // Leftmost leaf holding the largest value of the subtree
+
+// Function to build the subtree of a node over the leaves from low to high, every leaf starting at minus its deadline
+void build_slack(int node, int low, int high)
+{
+    slack_add[node] = 0;
+
+    if (low == high)
+    {
+        slack_max[node] = -(long long)deadline_values[low];
+        slack_argmax[node] = low;
+        return;
+    }
+
+    int middle = (low + high) / 2;
+    build_slack(2 * node, low, middle);
+    build_slack(2 * node + 1, middle + 1, high);
+
+    int best = (slack_max[2 * node] >= slack_max[2 * node + 1]) ? 2 * node : 2 * node + 1;
+    slack_max[node] = slack_max[best];
+    slack_argmax[node] = slack_argmax[best];
+}
+
+// Function to add value to the leaves from first onwards
+void add_slack(int node, int low, int high, int first, long long value)
+{
+    if (high < first)
+        return;
+
+    if (low >= first)
+    {
+        slack_max[node] += value;
+        slack_add[node] += value;
+        return;
+    }
+
+    int middle = (low + high) / 2;
+    add_slack(2 * node, low, middle, first, value);
+    add_slack(2 * node + 1, middle + 1, high, first, value);
+
+    int best = (slack_max[2 * node] >= slack_max[2 * node + 1]) ? 2 * node : 2 * node + 1;
+    slack_max[node] = slack_max[best] + slack_add[node];
+    slack_argmax[node] = slack_argmax[best];
+}
+
+// Function to find the largest leaf value from first onwards, storing the leftmost leaf that holds it in *position
+long long max_slack(int node, int low, int high, int first, int *position)
+{
+    if (high < first)
+        return -__LONG_LONG_MAX__;
+
+    if (low >= first)
+    {
+        *position = slack_argmax[node];
+        return slack_max[node];
+    }
+
+    int middle = (low + high) / 2, right_position;
+    long long left = max_slack(2 * node, low, middle, first, position);
+    long long right = max_slack(2 * node + 1, middle + 1, high, first, &right_position);
+
+    if (right > left)
+    {
+        left = right;
+        *position = right_position;
+    }
+
+    return left + slack_add[node];
+}
+
+// Function to find the first of the distinct deadlines which is not below value
+int first_deadline_from(int value)
+{
+    int low = 0, high = deadline_count;
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (deadline_values[middle] < value)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+// Function to run the admission test on the workload and print its result
+// Returns 1 if the workload is admitted, 0 if it is not, -1 if the memory for the test is not available
+// The density test (sum of burst / relative deadline at most 1) is a quick sufficient check, the processor demand
+// test is exact for pre-emptive EDF: every interval [a, d] must hold the work of the processes that arrive at or
+// after a and are due by d. The start a sweeps the arrivals from the latest down, adding the burst of every process
+// arriving at a to all deadlines from its own on, so the busiest interval starting at a is a maximum query over the
+// deadlines from a on, O(n log n) over the whole workload
+int admission_test()
+{
+    double density = 0;
+    int feasible = 1;
+
+    for (int i = 0; i < n; i++)
+        density += (double)processes[i].burst_time / processes[i].relative_deadline;
+
+    printf("\nAdmission Test:\n");
+    printf("Density: %.4f (%s the bound of 1)\n", density, (density <= 1) ? "within" : "above");
+
+    deadline_values = malloc(n * sizeof(int));
+    slack_max = malloc(4 * (size_t)n * sizeof(long long));
+    slack_add = malloc(4 * (size_t)n * sizeof(long long));
+    slack_argmax = malloc(4 * (size_t)n * sizeof(int));
+
+    if (deadline_values == NULL || slack_max == NULL || slack_add == NULL || slack_argmax == NULL)
+    {
+        printf("Could not allocate the processor demand test.\n");
+        return -1;
+    }
+
+    // Collect the distinct deadlines, and sort the processes by arrival for the sweep
+    for (int i = 0; i < n; i++)
+        deadline_values[i] = deadline(&processes[i]);
+
+    qsort(deadline_values, n, sizeof(int), compare_int);
+
+    deadline_count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (deadline_count == 0 || deadline_values[deadline_count - 1] != deadline_values[i])
+            deadline_values[deadline_count++] = deadline_values[i];
+    }
+
+    qsort(processes, n, sizeof(Process), compare_arrival);
+    build_slack(1, 0, deadline_count - 1);
+
+    for (int i = n - 1; i >= 0 && feasible; )
+    {
+        int start = processes[i].arrival_time, end;
+
+        // Add the work of every process arriving at the start of the interval
+        for (; i >= 0 && processes[i].arrival_time == start; i--)
+            add_slack(1, 0, deadline_count - 1, first_deadline_from(deadline(&processes[i])), processes[i].burst_time);
+
+        long long excess = max_slack(1, 0, deadline_count - 1, first_deadline_from(start), &end) + start;
+
+        if (excess > 0)
+        {
+            end = deadline_values[end];
+            printf("Processor demand %lld exceeds the interval [%d, %d].\n", excess + end - start, start, end);
+            feasible = 0;
+        }
+    }
+
+    printf("Processor demand test: %s\n", feasible ? "passed, every deadline can be met" : "failed, some deadline will be missed");
+
+    free(deadline_values);
+    free(slack_max);
+    free(slack_add);
+    free(slack_argmax);
+
+    return feasible;
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    long long total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    long long total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the deadline statistics: miss count, lateness distribution and tardiness
+void print_deadline_statistics()
+{
+    int misses = 0, max_tardiness = 0;
+    long long total_lateness = 0, total_tardiness = 0;
+    int *sorted = malloc(n * sizeof(int));  // Lateness values in increasing order
+
+    if (sorted == NULL)
+    {
+        printf("Could not allocate the deadline statistics.\n");
+        return;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if (lateness(&processes[i]) > 0)
+            misses++;
+
+        total_lateness += lateness(&processes[i]);
+        total_tardiness += tardiness(&processes[i]);
+
+        if (tardiness(&processes[i]) > max_tardiness)
+            max_tardiness = tardiness(&processes[i]);
+
+        sorted[i] = lateness(&processes[i]);
+    }
+
+    // Sort the lateness values in O(n log n) for the median
+    qsort(sorted, n, sizeof(int), compare_int);
+
+    printf("\nDeadline Misses: %d of %d\n", misses, n);
+    printf("Lateness: min = %d, median = %d, max = %d, average = %.2f\n", sorted[0], sorted[(n - 1) / 2], sorted[n - 1], (float)total_lateness / n);
+    printf("Tardiness: total = %lld, max = %d, average = %.2f\n", total_tardiness, max_tardiness, (float)total_tardiness / n);
+
+    free(sorted);
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |   Deadline    |     C . T     |   T . A . T   |     W . T     |   Lateness    |\n");
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            deadline(&processes[i]),
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            lateness(&processes[i])
+        );
+
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    int admission_only = 0;     // Set by --admission
+    const char *workload_path = NULL;   // Workload file to read instead of the interactive input, if requested
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--non-preemptive") == 0)
+        {
+            preemptive = 0;
+        }
+        else if (strcmp(argv[i], "--admission") == 0)
+        {
+            admission_only = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_large_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of at least one process from %s.\n", workload_path);
+            return 1;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].relative_deadline <= 0)
+            {
+                printf("Deadline must be positive.\n");
+                return 1;
+            }
+        }
+    }
+    else
+    {
+        if (allocate_processes(MAX_PROCESS) == -1)
+        {
+            printf("Could not allocate the processes.\n");
+            return 1;
+        }
+
+        // Input the number of processes from the user
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Ensure that the number of processes is within the allowed limit
+        if (n < 1 || n > MAX_PROCESS)
+        {
+            printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        // Input the arrival time, burst time and deadline for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+            printf("Enter the deadline of P%d (relative to its arrival): ", i + 1);
+            scanf("%d", &processes[i].relative_deadline);
+
+            if (processes[i].relative_deadline <= 0)
+            {
+                printf("Deadline must be positive.\n");
+                return 1;
+            }
+        }
+    }
+
+    // With --admission, only check whether the workload can meet all its deadlines
+    if (admission_only)
+    {
+        int admitted = admission_test();
+
+        return (admitted == -1) ? 1 : (admitted ? 0 : 2);
+    }
+
+    edf_scheduling();   // Perform the EDF Scheduling algorithm and calculate completion time, turnaround time, waiting time, lateness and tardiness for each process
+
+    // A workload file may hold millions of processes, so only the averages and the deadline statistics are printed for it
+    if (workload_path == NULL)
+    {
+        print_gantt_chart();        // Print the Gantt chart
+
+        print_resultant_table();    // Print the resultant table with process details
+    }
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    print_deadline_statistics();    // Print the deadline misses, lateness and tardiness
+
+    return 0;   // Return 0 to indicate successful execution
+}
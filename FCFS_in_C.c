@@ -1,6 +1,19 @@
+#define _DEFAULT_SOURCE  // clock_gettime, futimens and kill are POSIX, declare them under -std=c11 as well
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 #define MAX_PROCESS 10 // Define the maximum number of processes
+#define ENABLE_STATS 1  // Set to 0 to compile the hot-path counters and timers out of the engine
+#define RESULT_COLUMNS 6  // Number of columns in the resultant table
+#define CACHE_TAG "FCFS"  // Name of the policy in the cache key, so programs sharing a cache directory never mix results
+#define CACHE_NO_GANTT  // Only the process array is cached, FCFS runs the processes in their sorted order
+#define BUSY_PERIODS_ENGINE() fcfs_scheduling()  // Engine run by --busy-periods on every busy period
+#define BUSY_PERIODS_SORTED  // fcfs_scheduling sorts the processes by arrival time
+#define BUSY_PERIODS_NO_GANTT  // The Gantt chart is drawn from the process array
+#define MAX_SCAN_THREADS 256  // Largest number of threads of the parallel scan
 
 // Structure to represent a process with necessary attributes
 typedef struct  
@@ -9,20 +22,97 @@ typedef struct
     int arrival_time;       // Arrival time of the process
     int burst_time;         // Burst time (CPU time required) of the process
     int completion_time;    // Completion time after process execution
-    int turn_around_time;   // Turnaround time = Completion time - Arrival time
-    int waiting_time;       // Waiting time = Turnaround time - Burst time
 } Process;
 
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
 Process processes[MAX_PROCESS];   // Declare an array of processes with a maximum size of 10
 
 int n;  // Global variable to store the number of processes
 
+int next_process_id;    // Process ID given to the next process inserted in the what-if mode
+
+int total_turnaround_time = 0, total_waiting_time = 0;  // Running totals kept up to date by every schedule change
+
+// Workload scheduled by the parallel scan (--threads), held in allocated columns since it is not bounded by MAX_PROCESS
+int *scan_arrival, *scan_burst, *scan_completion;   // Columns of the workload, NULL outside the parallel scan
+
+// Structure to hold the hot-path counters and phase timers reported by --stats
+typedef struct
+{
+    long long events;       // Iterations of the scheduling loop
+    long long dispatches;   // Times a process was picked to run
+    long long scanned;      // Candidates examined while picking a process
+    long long idle_jumps;   // Jumps of the clock over an idle gap
+    long long sort_swaps;   // Swaps made while sorting by arrival time
+    double sort_time;       // Seconds spent sorting by arrival time
+    double schedule_time;   // Seconds spent in the scheduling loop
+    double output_time;     // Seconds spent printing and writing the results
+} Stats;
+
+Stats stats;    // Counters and timers of the current run
+
+// Function to read the monotonic clock in seconds
+double monotonic_seconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// The counters and timers compile to nothing when ENABLE_STATS is 0
+#if ENABLE_STATS
+#define STAT_ADD(counter, amount) (stats.counter += (amount))
+#define STAT_TIMER_START(timer) double timer##_started = monotonic_seconds()
+#define STAT_TIMER_STOP(timer) (stats.timer += monotonic_seconds() - timer##_started)
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#define STAT_TIMER_START(timer) ((void)0)
+#define STAT_TIMER_STOP(timer) ((void)0)
+#endif
+
+// Function to print the profile of the run collected by the counters and timers
+void print_stats()
+{
+    printf("\nStatistics:\n");
+#if ENABLE_STATS
+    printf("Events processed:     %lld\n", stats.events);
+    printf("Dispatches:           %lld\n", stats.dispatches);
+    printf("Candidates scanned:   %lld\n", stats.scanned);
+    printf("Idle jumps:           %lld\n", stats.idle_jumps);
+    printf("Sort swaps:           %lld\n", stats.sort_swaps);
+    printf("Sort time:            %.6f s\n", stats.sort_time);
+    printf("Scheduling time:      %.6f s\n", stats.schedule_time);
+    printf("Output time:          %.6f s\n", stats.output_time);
+#else
+    printf("Statistics were compiled out, rebuild with ENABLE_STATS set to 1.\n");
+#endif
+}
+
+// Windowed telemetry of the run, recorded by the engine through telemetry_busy and telemetry_completion
+#include "Telemetry.h"
+
 // Function to perform First-Come, First-Served (FCFS) scheduling and calculate the completion time, turnaround time and waiting time
 void fcfs_scheduling() 
 {
+    STAT_TIMER_START(sort_time);
+
     // Sort the processes based on their arrival time using bubble sort
     for (int i = 0; i < n; i++) 
     {
+        int swapped = 0;
+
         for (int j = 0; j < n - i - 1; j++) 
         {
             if (processes[j].arrival_time > processes[j + 1].arrival_time) 
@@ -31,51 +121,196 @@ void fcfs_scheduling()
                 Process temp = processes[j];
                 processes[j] = processes[j + 1];
                 processes[j + 1] = temp;
+                STAT_ADD(sort_swaps, 1);
+                swapped = 1;
             }
         }
+
+        // Stop early once a pass makes no swaps, so an already sorted trace costs a single pass
+        if (!swapped)
+            break;
     }
 
+    STAT_TIMER_STOP(sort_time);
+
     int current_time = 0;
 
+    total_turnaround_time = 0;
+    total_waiting_time = 0;
+
+    STAT_TIMER_START(schedule_time);
+
     // Loop through all processes and calculate their completion time, turnaround time, and waiting time
     for (int i = 0; i < n; i++) 
     {
+        STAT_ADD(events, 1);
+        STAT_ADD(dispatches, 1);
+
         // If the current time is less than the arrival time of the process, move current time to arrival time
         if (current_time < processes[i].arrival_time)
+        {
             current_time = processes[i].arrival_time;
+            STAT_ADD(idle_jumps, 1);
+        }
 
         // Calculate the completion time by adding burst time to the current time
         processes[i].completion_time = current_time + processes[i].burst_time;
 
-        processes[i].turn_around_time = processes[i].completion_time - processes[i].arrival_time;   // Calculate the turnaround time
-        processes[i].waiting_time = processes[i].turn_around_time - processes[i].burst_time;        // Calculate the waiting time
+        // Record the execution in the telemetry windows
+        telemetry_busy(current_time, processes[i].completion_time);
+        telemetry_completion(processes[i].completion_time);
+
+        total_turnaround_time += turn_around_time(&processes[i]);
+        total_waiting_time += waiting_time(&processes[i]);
 
         current_time = processes[i].completion_time;    // Update the current time after the process completes
     }
+
+    STAT_TIMER_STOP(schedule_time);
 }
 
-// Function to calculate the average turnaround time of all processes
-float calculate_average_turnaround_time() 
+// Function to recompute the schedule from the given index onwards after a change
+// Stops as soon as a process keeps its old completion time, since every later process then keeps its old values too
+// A change early in a busy period can still move every later completion, so an update costs O(n) in the worst case
+void fcfs_update_from(int start)
 {
-    int total_turnaround_time = 0;  // Variable to store total turnaround time
+    int current_time = (start > 0) ? processes[start - 1].completion_time : 0;
 
-    // Loop through all processes and accumulate the total turnaround time
+    for (int i = start; i < n; i++)
+    {
+        STAT_ADD(events, 1);
+
+        if (current_time < processes[i].arrival_time)
+            current_time = processes[i].arrival_time;
+
+        // The rest of the schedule is unaffected by the change
+        if (processes[i].completion_time == current_time + processes[i].burst_time)
+            break;
+
+        // Replace the old contribution of the process in the running totals with the new one, a new process has none
+        if (processes[i].completion_time != -1)
+        {
+            total_turnaround_time -= turn_around_time(&processes[i]);
+            total_waiting_time -= waiting_time(&processes[i]);
+        }
+
+        processes[i].completion_time = current_time + processes[i].burst_time;
+        total_turnaround_time += turn_around_time(&processes[i]);
+        total_waiting_time += waiting_time(&processes[i]);
+
+        current_time = processes[i].completion_time;
+    }
+}
+
+// Function to find the index of a process from its process ID, returns -1 if there is no such process
+int find_process(int process_id)
+{
     for (int i = 0; i < n; i++)
-        total_turnaround_time += processes[i].turn_around_time;
+    {
+        if (processes[i].process_id == process_id)
+            return i;
+    }
 
-    return (float)total_turnaround_time / n;    // Return the average turnaround time
+    return -1;
 }
 
-// Function to calculate the average waiting time of all processes
-float calculate_average_waiting_time() 
+// Function to insert a new process into the schedule, returns 0 on success and -1 if the schedule is full
+// The position is found in O(log n), but the shift and the update are O(n), which is nothing at MAX_PROCESS processes
+int fcfs_insert_process(int arrival_time, int burst_time)
+{
+    if (n >= MAX_PROCESS)
+        return -1;
+
+    // Binary search for the position after every process arriving at or before the new one
+    int low = 0, high = n;
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+
+        if (processes[mid].arrival_time <= arrival_time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    // Shift the later processes one place to the right to make room for the new one
+    for (int i = n; i > low; i--)
+        processes[i] = processes[i - 1];
+
+    processes[low].process_id = next_process_id++;
+    processes[low].arrival_time = arrival_time;
+    processes[low].burst_time = burst_time;
+    processes[low].completion_time = -1;    // Not scheduled yet
+    n++;
+
+    fcfs_update_from(low);
+    return 0;
+}
+
+// Function to remove a process from the schedule, returns 0 on success and -1 if the process does not exist
+int fcfs_remove_process(int process_id)
 {
-    int total_waiting_time = 0; // Variable to store total waiting time
+    int index = find_process(process_id);
+
+    if (index == -1)
+        return -1;
+
+    total_turnaround_time -= turn_around_time(&processes[index]);
+    total_waiting_time -= waiting_time(&processes[index]);
+
+    // Shift the later processes one place to the left to close the gap
+    for (int i = index; i < n - 1; i++)
+        processes[i] = processes[i + 1];
+    n--;
+
+    fcfs_update_from(index);
+    return 0;
+}
+
+// Function to change the burst time of a process, returns 0 on success and -1 if the process does not exist
+int fcfs_change_burst_time(int process_id, int burst_time)
+{
+    int index = find_process(process_id);
+
+    if (index == -1)
+        return -1;
+
+    // The waiting time is derived from the burst time, so move it in the running total along with the new burst time
+    total_waiting_time -= waiting_time(&processes[index]);
+    processes[index].burst_time = burst_time;
+    total_waiting_time += waiting_time(&processes[index]);
 
-    // Loop through all processes and accumulate the total waiting time
+    fcfs_update_from(index);
+    return 0;
+}
+
+// Function to recompute the running totals from the process array, when the engine did not run in this process
+void recompute_totals()
+{
+    total_turnaround_time = total_waiting_time = 0;
     for (int i = 0; i < n; i++)
-        total_waiting_time += processes[i].waiting_time;
+    {
+        total_turnaround_time += turn_around_time(&processes[i]);
+        total_waiting_time += waiting_time(&processes[i]);
+    }
+}
+
+// Function to calculate the average turnaround time of all processes
+float calculate_average_turnaround_time() 
+{
+    if (n == 0)
+        return 0;
 
-    return (float)total_waiting_time / n;   // Return the average waiting time
+    return (float)total_turnaround_time / n;    // Return the average turnaround time from the running total
+}
+
+// Function to calculate the average waiting time of all processes
+float calculate_average_waiting_time() 
+{
+    if (n == 0)
+        return 0;
+
+    return (float)total_waiting_time / n;   // Return the average waiting time from the running total
 }
 
 // Function to print the resultant table (showing process details)
@@ -96,8 +331,8 @@ void print_resultant_table()
             processes[i].arrival_time, 
             processes[i].burst_time, 
             processes[i].completion_time, 
-            processes[i].turn_around_time, 
-            processes[i].waiting_time
+            turn_around_time(&processes[i]), 
+            waiting_time(&processes[i])
         );
     }
 
@@ -160,31 +395,468 @@ void print_gantt_chart()
     printf("\n");
 }
 
+#include "Gantt_Renderer.h"     // Streaming SVG renderer used by write_gantt_chart
+
+// Function to write the Gantt chart to a file as an SVG drawing, or as an HTML page when html is set
+// Returns 0 on success and -1 if the file cannot be opened or written
+int write_gantt_chart(const char *path, int html)
+{
+    FILE *file = fopen(path, "w");
+    Gantt_Renderer renderer;
+
+    if (file == NULL)
+        return -1;
+
+    int end_time = (n > 0) ? processes[n - 1].completion_time : 1;
+
+    begin_gantt_drawing(&renderer, file, end_time, html);
+
+    for (int i = 0; i < n; i++)
+        render_gantt_segment(&renderer, processes[i].process_id, processes[i].completion_time - processes[i].burst_time, processes[i].completion_time);
+
+    return end_gantt_drawing(&renderer, end_time, html);
+}
+
+// Column names of the resultant table, in the order they are written
+const char *result_columns[RESULT_COLUMNS] = {
+    "process_id",
+    "arrival_time",
+    "burst_time",
+    "completion_time",
+    "turn_around_time",
+    "waiting_time"
+};
+
+// Function to fill the columns of row i of the resultant table
+void result_row(int i, int values[])
+{
+    // The parallel scan keeps its rows in the allocated columns
+    if (scan_completion != NULL)
+    {
+        values[0] = i + 1;
+        values[1] = scan_arrival[i];
+        values[2] = scan_burst[i];
+        values[3] = scan_completion[i];
+        values[4] = scan_completion[i] - scan_arrival[i];
+        values[5] = scan_completion[i] - scan_arrival[i] - scan_burst[i];
+        return;
+    }
+
+    values[0] = processes[i].process_id;
+    values[1] = processes[i].arrival_time;
+    values[2] = processes[i].burst_time;
+    values[3] = processes[i].completion_time;
+    values[4] = turn_around_time(&processes[i]);
+    values[5] = waiting_time(&processes[i]);
+}
+
+#include "Result_Writer.h"      // write_results, writing the rows filled by result_row
+#include "Workload_Reader.h"    // load_workload, reading the files written by Trace_Import_in_C.c
+#include "Result_Cache.h"       // cache_lookup and cache_store, keyed by workload_key
+#include "Busy_Periods.h"       // run_busy_periods, simulating the busy periods in worker processes
+
+// Structure to represent one block of consecutive processes in the parallel scan
+// Run from a CPU that is free at time x, the block completes at max(x + shift, ready), so blocks compose like the processes
+typedef struct
+{
+    int first, last;                // The block holds processes first to last - 1
+    long long shift;                // Sum of the burst times of the block
+    long long ready;                // Completion time of the block when its first process starts on arrival
+    long long start;                // Time the CPU becomes free for the block, the completion time of the previous process
+    long long total_turnaround;     // Sum of the turnaround times of the block
+    long long total_waiting;        // Sum of the waiting times of the block
+    int sorted;                     // Cleared if the arrival times decrease inside the block
+} Scan_Block;
+
+Scan_Block scan_blocks[MAX_SCAN_THREADS];  // Blocks of the parallel scan, one per thread
+
+// Function to store a record of the workload file in the columns of the parallel scan
+void store_scan_record(int index, int arrival_time, int burst_time, int priority)
+{
+    (void)priority;
+    scan_arrival[index] = arrival_time;
+    scan_burst[index] = burst_time;
+}
+
+// Function to read a workload of any size into the columns of the parallel scan, returns the number of processes, -1 on error
+int load_scan_workload(const char *path)
+{
+    long long count = count_workload_records(path);
+
+    if (count < 1 || count > __INT_MAX__)
+        return -1;
+
+    scan_arrival = malloc(count * sizeof(int));
+    scan_burst = malloc(count * sizeof(int));
+    scan_completion = malloc(count * sizeof(int));
+
+    if (scan_arrival == NULL || scan_burst == NULL || scan_completion == NULL)
+        return -1;
+
+    n = read_workload(path, (int)count, store_scan_record);
+    return n;
+}
+
+// Function to compose the processes of a block into its shift and ready time, run by one thread per block
+void *summarize_scan_block(void *argument)
+{
+    Scan_Block *block = argument;
+    long long shift = 0, ready = scan_arrival[block->first];
+
+    block->sorted = 1;
+    for (int i = block->first; i < block->last; i++)
+    {
+        if (i > block->first && scan_arrival[i] < scan_arrival[i - 1])
+            block->sorted = 0;
+
+        // The same recurrence as fcfs_scheduling, from the first arrival of the block instead of a known start
+        if (ready < scan_arrival[i])
+            ready = scan_arrival[i];
+        ready += scan_burst[i];
+        shift += scan_burst[i];
+    }
+
+    block->shift = shift;
+    block->ready = ready;
+    return NULL;
+}
+
+// Function to compute the completion times of a block from its start time, run by one thread per block
+void *complete_scan_block(void *argument)
+{
+    Scan_Block *block = argument;
+    long long current_time = block->start, total_turnaround = 0, total_waiting = 0;
+
+    for (int i = block->first; i < block->last; i++)
+    {
+        if (current_time < scan_arrival[i])
+            current_time = scan_arrival[i];
+        current_time += scan_burst[i];
+
+        scan_completion[i] = (int)current_time;
+        total_turnaround += current_time - scan_arrival[i];
+        total_waiting += current_time - scan_arrival[i] - scan_burst[i];
+    }
+
+    block->total_turnaround = total_turnaround;
+    block->total_waiting = total_waiting;
+    return NULL;
+}
+
+// Function to run one pass of the parallel scan on every block, each block on its own thread
+// A block whose thread cannot be started is processed by the calling thread instead
+void run_scan_pass(void *(*pass)(void *), int blocks)
+{
+    pthread_t threads[MAX_SCAN_THREADS];
+    int started[MAX_SCAN_THREADS];
+
+    for (int b = 0; b < blocks; b++)
+    {
+        started[b] = (pthread_create(&threads[b], NULL, pass, &scan_blocks[b]) == 0);
+        if (!started[b])
+            pass(&scan_blocks[b]);
+    }
+
+    for (int b = 0; b < blocks; b++)
+    {
+        if (started[b])
+            pthread_join(threads[b], NULL);
+    }
+}
+
+// Function to perform FCFS scheduling of the loaded columns as a parallel prefix scan on the given number of threads
+// Each process maps the time the CPU becomes free to its completion time, x -> max(x, arrival) + burst, and these
+// maps compose associatively, so the blocks are summarized in parallel, a short serial pass over the block summaries
+// gives the start of every block, and the blocks then fill in their completion times in parallel
+// Returns 0 on success, -1 if the arrival times are not sorted, which FCFS order requires here, and -2 if a completion
+// time would not fit in an int
+int fcfs_parallel_scan(int threads)
+{
+    int blocks = (threads < n) ? threads : n;
+
+    STAT_TIMER_START(schedule_time);
+
+    for (int b = 0; b < blocks; b++)
+    {
+        scan_blocks[b].first = (int)((long long)n * b / blocks);
+        scan_blocks[b].last = (int)((long long)n * (b + 1) / blocks);
+    }
+
+    run_scan_pass(summarize_scan_block, blocks);
+
+    // Chain the block summaries, the CPU is free from time 0 like in fcfs_scheduling
+    long long current_time = 0;
+
+    for (int b = 0; b < blocks; b++)
+    {
+        if (!scan_blocks[b].sorted || (b > 0 && scan_arrival[scan_blocks[b].first] < scan_arrival[scan_blocks[b].first - 1]))
+            return -1;
+
+        scan_blocks[b].start = current_time;
+        current_time = (current_time + scan_blocks[b].shift > scan_blocks[b].ready) ? current_time + scan_blocks[b].shift : scan_blocks[b].ready;
+    }
+
+    // Completion times only grow in FCFS order, so the last one is the largest
+    if (current_time > __INT_MAX__)
+        return -2;
+
+    run_scan_pass(complete_scan_block, blocks);
+
+    STAT_TIMER_STOP(schedule_time);
+    STAT_ADD(events, n);
+    STAT_ADD(dispatches, n);
+    return 0;
+}
+
 // Main function: Entry point of the program
-int main() 
+int main(int argc, char *argv[])
 {
-    // Input the number of processes from the user
-    printf("Enter the number of processes: ");
-    scanf("%d", &n);
+    const char *output_path = NULL;     // File for the machine-readable results, if requested
+    int output_format = FORMAT_CSV;     // Format of the machine-readable results
+    const char *gantt_path = NULL;      // File for the drawn Gantt chart, if requested
+    int gantt_html = 0;                 // Set when the Gantt chart is drawn as an HTML page
+    int show_stats = 0;                 // Set by --stats
+    const char *telemetry_path = NULL;  // File for the windowed telemetry, if requested
+    int window_width = 10;              // Width of a telemetry window in units of time
+    const char *workload_path = NULL;   // Binary workload to read instead of the interactive input, if requested
+    const char *cache_dir = NULL;       // Directory of cached results, if requested
+    int busy_workers = 0;               // Worker processes of --busy-periods, 0 to run the engine once over the whole workload
+    int what_if = 0;                    // Set by --what-if
+    int scan_threads = 0;               // Threads of the parallel scan set by --threads, 0 to use the interactive engine
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stats") == 0)
+        {
+            show_stats = 1;
+        }
+        else if (strcmp(argv[i], "--what-if") == 0)
+        {
+            what_if = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--cache") == 0)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--busy-periods") == 0)
+        {
+            busy_workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0)
+        {
+            scan_threads = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--telemetry") == 0)
+        {
+            telemetry_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--window") == 0)
+        {
+            window_width = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--csv") == 0)
+        {
+            output_format = FORMAT_CSV;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--jsonl") == 0)
+        {
+            output_format = FORMAT_JSONL;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--binary") == 0)
+        {
+            output_format = FORMAT_BINARY;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && (strcmp(argv[i], "--svg") == 0 || strcmp(argv[i], "--html") == 0))
+        {
+            gantt_html = (strcmp(argv[i], "--html") == 0);
+            gantt_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
 
-    // Ensure that the number of processes is within the allowed limit
-    if (n > MAX_PROCESS) 
+    if (window_width <= 0)
     {
-        printf("Number of processes cannot exceed %d.\n", MAX_PROCESS);
-        return 1; // Exit if the number exceeds the maximum allowed
+        printf("Telemetry window width must be positive.\n");
+        return 1;
     }
 
-    // Input the arrival and burst times for each process from the user
-    for (int i = 0; i < n; i++) 
+    if (busy_workers < 0 || busy_workers > MAX_BUSY_WORKERS)
     {
-        processes[i].process_id = i + 1;    // Set the process ID to a unique number starting from 1
-        printf("Enter the arrival time of P%d: ", i + 1);
-        scanf("%d", &processes[i].arrival_time);
-        printf("Enter the burst time of P%d: ", i + 1);
-        scanf("%d", &processes[i].burst_time);
+        printf("Number of busy period workers must be between 1 and %d.\n", MAX_BUSY_WORKERS);
+        return 1;
     }
 
-    fcfs_scheduling();          // Perform the FCFS scheduling algorithm and calculate the completion time, turnaround time, and waiting time for each process
+    // The engine records the telemetry and the counters in the workers, where they would be lost
+    if (busy_workers > 0 && (telemetry_path != NULL || show_stats))
+    {
+        printf("--busy-periods cannot be combined with --telemetry, --stats.\n");
+        return 1;
+    }
+
+    // With --threads, schedule a workload file of any size with the parallel scan and print the averages instead of the chart and table
+    if (scan_threads != 0)
+    {
+        if (scan_threads < 0 || scan_threads > MAX_SCAN_THREADS)
+        {
+            printf("Number of threads must be between 1 and %d.\n", MAX_SCAN_THREADS);
+            return 1;
+        }
+
+        if (workload_path == NULL || gantt_path != NULL || telemetry_path != NULL || cache_dir != NULL || what_if || busy_workers > 0)
+        {
+            printf("--threads needs --workload and can only be combined with --csv, --jsonl, --binary and --stats.\n");
+            return 1;
+        }
+
+        if (load_scan_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of at least one process from %s.\n", workload_path);
+            return 1;
+        }
+
+        int scan_result = fcfs_parallel_scan(scan_threads);
+
+        if (scan_result == -1)
+        {
+            printf("--threads needs a workload sorted by arrival time.\n");
+            return 1;
+        }
+
+        if (scan_result == -2)
+        {
+            printf("The completion times of the workload exceed %d.\n", __INT_MAX__);
+            return 1;
+        }
+
+        long long scan_turnaround = 0, scan_waiting = 0;
+
+        for (int b = 0; b < scan_threads && b < n; b++)
+        {
+            scan_turnaround += scan_blocks[b].total_turnaround;
+            scan_waiting += scan_blocks[b].total_waiting;
+        }
+
+        STAT_TIMER_START(output_time);
+
+        printf("\nScheduled %d processes on %d threads.\n", n, scan_threads);
+        printf("Average Turnaround Time: %f\n", (n > 0) ? (double)scan_turnaround / n : 0.0);
+        printf("Average Waiting Time: %f\n", (n > 0) ? (double)scan_waiting / n : 0.0);
+
+        if (output_path != NULL && write_results(output_path, output_format) == -1)
+        {
+            printf("Could not write the results to %s.\n", output_path);
+            return 1;
+        }
+
+        STAT_TIMER_STOP(output_time);
+
+        if (show_stats)
+            print_stats();
+
+        free(scan_arrival);
+        free(scan_burst);
+        free(scan_completion);
+        return 0;
+    }
+
+    // The engine itself feeds the telemetry, so runs with telemetry are not cached
+    if (telemetry_path != NULL)
+        cache_dir = NULL;
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of 1 to %d processes from %s.\n", MAX_PROCESS, workload_path);
+            return 1;
+        }
+    }
+    else
+    {
+        // Input the number of processes from the user
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Ensure that the number of processes is within the allowed limit
+        if (n > MAX_PROCESS) 
+        {
+            printf("Number of processes cannot exceed %d.\n", MAX_PROCESS);
+            return 1; // Exit if the number exceeds the maximum allowed
+        }
+
+        // Input the arrival and burst times for each process from the user
+        for (int i = 0; i < n; i++) 
+        {
+            processes[i].process_id = i + 1;    // Set the process ID to a unique number starting from 1
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+        }
+    }
+
+    next_process_id = n + 1;
+
+    // Start the windowed telemetry if requested, the engine feeds it while it runs
+    if (telemetry_path != NULL && begin_telemetry(telemetry_path, window_width) == -1)
+    {
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
+    }
+
+    unsigned long long cache_key = (cache_dir != NULL) ? workload_key() : 0;   // Key of the cached result, taken before the engine reorders the processes
+
+    // Reuse the cached result of the same workload and parameters if there is one, otherwise run the engine and cache its result
+    if (cache_dir != NULL && cache_lookup(cache_dir, cache_key) == 0)
+    {
+        printf("\nResult loaded from the cache.\n");
+
+        recompute_totals();
+    }
+    else
+    {
+        // With --busy-periods, simulate the busy periods in worker processes instead of running the engine once
+        if (busy_workers > 0)
+        {
+            int periods = run_busy_periods(busy_workers);
+
+            if (periods == -1)
+            {
+                printf("Could not simulate the busy periods in worker processes.\n");
+                return 1;
+            }
+            printf("\nSimulated %d busy periods on %d worker processes.\n", periods, (busy_workers < periods) ? busy_workers : periods);
+            recompute_totals();
+        }
+        else
+        {
+            fcfs_scheduling();          // Perform the FCFS scheduling algorithm and calculate the completion time, turnaround time, and waiting time for each process
+        }
+
+        if (cache_dir != NULL && cache_store(cache_dir, cache_key) == -1)
+            printf("Could not write the result to the cache in %s.\n", cache_dir);
+    }
+
+    if (end_telemetry() == -1)
+    {
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
+    }
+
+    STAT_TIMER_START(output_time);
 
     print_gantt_chart();        // Print the Gantt chart showing process execution order and times
     
@@ -194,5 +866,83 @@ int main()
     printf("\nAverage Turnaround Time: %f\n", calculate_average_turnaround_time());
     printf("Average Waiting Time: %f\n", calculate_average_waiting_time());
 
+    // Write the results in the requested machine-readable format
+    if (output_path != NULL && write_results(output_path, output_format) == -1)
+    {
+        printf("Could not write the results to %s.\n", output_path);
+        return 1;
+    }
+
+    // Draw the Gantt chart to a file if requested
+    if (gantt_path != NULL && write_gantt_chart(gantt_path, gantt_html) == -1)
+    {
+        printf("Could not write the Gantt chart to %s.\n", gantt_path);
+        return 1;
+    }
+
+    STAT_TIMER_STOP(output_time);
+
+    // Print where the run spent its time if requested
+    if (show_stats)
+        print_stats();
+
+    // What-if mode, if requested: change the workload and update only the affected part of the schedule
+    int choice = what_if ? -1 : 0;
+    while (choice != 0)
+    {
+        printf("\nWhat-if: 1. Insert a process  2. Remove a process  3. Change burst time  0. Exit\n");
+        printf("Enter your choice: ");
+        if (scanf("%d", &choice) != 1)
+            break;
+
+        int process_id, arrival_time, burst_time, result = 0;
+
+        if (choice == 1)
+        {
+            printf("Enter the arrival time of the new process: ");
+            if (scanf("%d", &arrival_time) != 1)
+                break;
+            printf("Enter the burst time of the new process: ");
+            if (scanf("%d", &burst_time) != 1)
+                break;
+            result = fcfs_insert_process(arrival_time, burst_time);
+            if (result == -1)
+                printf("Number of processes cannot exceed %d.\n", MAX_PROCESS);
+        }
+        else if (choice == 2)
+        {
+            printf("Enter the process ID to remove: P");
+            if (scanf("%d", &process_id) != 1)
+                break;
+            result = fcfs_remove_process(process_id);
+            if (result == -1)
+                printf("There is no process P%d.\n", process_id);
+        }
+        else if (choice == 3)
+        {
+            printf("Enter the process ID: P");
+            if (scanf("%d", &process_id) != 1)
+                break;
+            printf("Enter the new burst time of P%d: ", process_id);
+            if (scanf("%d", &burst_time) != 1)
+                break;
+            result = fcfs_change_burst_time(process_id, burst_time);
+            if (result == -1)
+                printf("There is no process P%d.\n", process_id);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (result == 0 && n > 0)
+        {
+            print_gantt_chart();
+            print_resultant_table();
+            printf("\nAverage Turnaround Time: %f\n", calculate_average_turnaround_time());
+            printf("Average Waiting Time: %f\n", calculate_average_waiting_time());
+        }
+    }
+
     return 0; // Return 0 to indicate successful execution
 }
@@ -0,0 +1,472 @@
+#include <stdio.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes that can be handled
+#define MAX_GROUPS 10   // Maximum number of process groups
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+#define WEIGHT_SCALE 1048576  // Virtual time a group is charged for one unit of CPU time at weight 1, also the largest weight
+
+// Scheduling policies available inside a group
+enum { POLICY_ROUND_ROBIN, POLICY_SJF, POLICY_PRIORITY };
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int group_id;          // Group the process belongs to
+    int priority;          // Priority of the process within its group (0 being the highest)
+    int completion_time;   // Time at which the process finishes execution
+    int remaining_time;    // Remaining time for the process to execute
+    int sequence;          // Order in which the process entered its group queue, the last tie-breaker
+} Process;
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Structure to represent a group of processes sharing one weight
+typedef struct
+{
+    int weight;                 // Share of the CPU relative to the other groups
+    long long virtual_time;     // CPU time received, scaled by WEIGHT_SCALE / weight, the group with the least runs next
+    long long virtual_remainder;  // Part of the scaled charge smaller than one unit of virtual time, carried to the next charge
+    int queue[MAX_PROCESS];     // Ready processes of the group as a binary min-heap, ordered by the group policy
+    int queue_size;             // Number of ready processes in the group
+    int in_heap;                // Set while the group is in group_heap, so it is never pushed twice
+} Group;
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
+Process processes[MAX_PROCESS]; // Array of processes
+Group groups[MAX_GROUPS]; // Array of groups
+int I = 0;  // Gantt chart tracker index
+int n, number_of_groups, q;  // Number of processes, number of groups and time quantum
+int policy = POLICY_ROUND_ROBIN;  // Policy used to pick a process inside a group
+
+int group_heap[MAX_GROUPS];  // Groups with ready processes as a binary min-heap, ordered by virtual time
+int group_heap_size = 0;     // Number of groups with ready processes
+long long global_virtual_time = 0;  // Virtual time of the most recently served group
+int next_sequence = 0;       // Sequence number given to the next process entering a group queue
+
+// Function to check whether group a must be served before group b: less virtual time first, then lower group number
+int group_before(int a, int b)
+{
+    if (groups[a].virtual_time != groups[b].virtual_time)
+        return groups[a].virtual_time < groups[b].virtual_time;
+
+    return a < b;
+}
+
+// Function to check whether process a must run before process b inside their group
+// Round Robin orders by queue entry only, SJF by remaining time and Priority by priority, then by queue entry
+int process_before(int a, int b)
+{
+    if (policy == POLICY_SJF && processes[a].remaining_time != processes[b].remaining_time)
+        return processes[a].remaining_time < processes[b].remaining_time;
+
+    if (policy == POLICY_PRIORITY && processes[a].priority != processes[b].priority)
+        return processes[a].priority < processes[b].priority;
+
+    return processes[a].sequence < processes[b].sequence;
+}
+
+// Function to add an item to a binary min-heap ordered by the given comparison
+void heap_push(int *heap, int *size, int item, int (*before)(int, int))
+{
+    int i = (*size)++;
+
+    // Move the new item up until its parent comes before it
+    while (i > 0 && before(item, heap[(i - 1) / 2]))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    heap[i] = item;
+}
+
+// Function to remove and return the first item of a binary min-heap ordered by the given comparison
+int heap_pop(int *heap, int *size, int (*before)(int, int))
+{
+    int top = heap[0], last = heap[--(*size)], i = 0;
+
+    // Move the last item down from the root until both children come after it
+    while (2 * i + 1 < *size)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < *size && before(heap[child + 1], heap[child]))
+            child++;
+
+        if (!before(heap[child], last))
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = last;
+    return top;
+}
+
+// Function to put a group into the group heap unless it is already there
+// The running group is out of the heap while its quantum runs, and arrivals may activate it before it is put back
+void activate_group(int group_id)
+{
+    if (groups[group_id].in_heap)
+        return;
+
+    groups[group_id].in_heap = 1;
+    heap_push(group_heap, &group_heap_size, group_id, group_before);
+}
+
+// Function to put a ready process into its group queue, activating the group if it had no ready process
+void enqueue_process(int process)
+{
+    Group *group = &groups[processes[process].group_id];
+
+    processes[process].sequence = next_sequence++;
+
+    // A group that was idle rejoins at the current virtual time, so it cannot claim the CPU it did not use
+    if (group->queue_size == 0)
+    {
+        if (group->virtual_time < global_virtual_time)
+            group->virtual_time = global_virtual_time;
+
+        activate_group(processes[process].group_id);
+    }
+
+    heap_push(group->queue, &group->queue_size, process, process_before);
+}
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I < MAX_SLOTS)
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to perform Weighted Fair Share Scheduling and calculate the completion time, turnaround time and waiting time
+// Every quantum goes to the group that has received the least CPU time relative to its weight, and inside that group
+// to the first process under the group policy. Both levels are heaps, so a dispatch costs O(log groups + log processes)
+void fair_share_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+
+    // Initialize remaining time for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].completion_time = -1;
+    }
+
+    // Sort the processes based on their arrival time using bubble sort
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n - i - 1; j++)
+        {
+            if (processes[j].arrival_time > processes[j + 1].arrival_time)
+            {
+                // Swap the processes if their arrival time is in the wrong order
+                Process temp = processes[j];
+                processes[j] = processes[j + 1];
+                processes[j + 1] = temp;
+            }
+        }
+    }
+
+    while (completed_processes < n)
+    {
+        // Move every process that has arrived into its group queue
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+            enqueue_process(next_arrival++);
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (group_heap_size == 0)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            add_gantt_slot(-1, current_time);
+            continue;
+        }
+
+        int group_id = heap_pop(group_heap, &group_heap_size, group_before);
+        Group *group = &groups[group_id];
+        group->in_heap = 0;
+        int next_process = heap_pop(group->queue, &group->queue_size, process_before);
+        int run = (processes[next_process].remaining_time < q) ? processes[next_process].remaining_time : q;
+
+        // Run the process for one quantum, or less if it finishes earlier, and charge its group
+        current_time += run;
+        processes[next_process].remaining_time -= run;
+        global_virtual_time = group->virtual_time;
+
+        // Carry the remainder of the division, so a weight that does not divide WEIGHT_SCALE is not undercharged
+        long long charge = (long long)run * WEIGHT_SCALE + group->virtual_remainder;
+        group->virtual_time += charge / group->weight;
+        group->virtual_remainder = charge % group->weight;
+        add_gantt_slot(processes[next_process].process_id, current_time);
+
+        // Processes arriving now queue up before the process that was just running
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+            enqueue_process(next_arrival++);
+
+        if (processes[next_process].remaining_time == 0)
+        {
+            // Update the completion time for the process
+            processes[next_process].completion_time = current_time;
+            completed_processes++;
+
+            // Keep the group in the competition while it still has ready processes
+            if (group->queue_size > 0)
+                activate_group(group_id);
+        }
+        else if (group->queue_size == 0)
+        {
+            enqueue_process(next_process);  // The group becomes active again with just this process
+        }
+        else
+        {
+            processes[next_process].sequence = next_sequence++;
+            heap_push(group->queue, &group->queue_size, next_process, process_before);
+            activate_group(group_id);
+        }
+    }
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    int total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    int total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the average turnaround and waiting time of every group
+void print_group_averages()
+{
+    printf("\nGroup Averages:\n");
+
+    for (int g = 0; g < number_of_groups; g++)
+    {
+        int count = 0, total_turnaround_time = 0, total_waiting_time = 0;
+
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].group_id == g)
+            {
+                count++;
+                total_turnaround_time += turn_around_time(&processes[i]);
+                total_waiting_time += waiting_time(&processes[i]);
+            }
+        }
+
+        if (count > 0)
+            printf("Group %d (weight %d): Average Turnaround Time: %.2f, Average Waiting Time: %.2f\n",
+                g, groups[g].weight, (float)total_turnaround_time / count, (float)total_waiting_time / count);
+    }
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |     Group     |   Priority    |\n");
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            processes[i].group_id,
+            processes[i].priority
+        );
+
+    printf("---------------------------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main()
+{
+    // Input the number of processes from the user
+    printf("Enter the number of processes: ");
+    scanf("%d", &n);
+
+    // Ensure that the number of processes is within the allowed limit
+    if (n < 1 || n > MAX_PROCESS)
+    {
+        printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+        return 1;
+    }
+
+    // Input the groups and their weights
+    printf("Enter the number of groups: ");
+    scanf("%d", &number_of_groups);
+
+    if (number_of_groups < 1 || number_of_groups > MAX_GROUPS)
+    {
+        printf("Number of groups must be between 1 and %d.\n", MAX_GROUPS);
+        return 1;
+    }
+
+    for (int g = 0; g < number_of_groups; g++)
+    {
+        printf("Enter the weight of group %d: ", g);
+        scanf("%d", &groups[g].weight);
+
+        if (groups[g].weight <= 0 || groups[g].weight > WEIGHT_SCALE)
+        {
+            printf("Weight must be between 1 and %d.\n", WEIGHT_SCALE);
+            return 1;
+        }
+    }
+
+    printf("Enter the policy inside groups (0 for Round Robin, 1 for SJF, 2 for Priority): ");
+    scanf("%d", &policy);
+    printf("Enter the quantum number: ");
+    scanf("%d", &q);
+
+    if (policy < POLICY_ROUND_ROBIN || policy > POLICY_PRIORITY || q <= 0)
+    {
+        printf("Policy must be 0, 1 or 2 and the quantum must be positive.\n");
+        return 1;
+    }
+
+    // Input the arrival time, burst time, group and priority for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].process_id = i + 1;
+        printf("Enter the arrival time of P%d: ", i + 1);
+        scanf("%d", &processes[i].arrival_time);
+        printf("Enter the burst time of P%d: ", i + 1);
+        scanf("%d", &processes[i].burst_time);
+
+        if (processes[i].burst_time <= 0)
+        {
+            printf("Burst time must be positive.\n");
+            return 1;
+        }
+
+        printf("Enter the group of P%d: ", i + 1);
+        scanf("%d", &processes[i].group_id);
+
+        if (processes[i].group_id < 0 || processes[i].group_id >= number_of_groups)
+        {
+            printf("Group must be between 0 and %d.\n", number_of_groups - 1);
+            return 1;
+        }
+
+        processes[i].priority = 0;
+        if (policy == POLICY_PRIORITY)
+        {
+            printf("Enter the priority of P%d (0 being the highest): ", i + 1);
+            scanf("%d", &processes[i].priority);
+        }
+    }
+
+    fair_share_scheduling();    // Perform the Weighted Fair Share Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+
+    print_gantt_chart();        // Print the Gantt chart
+
+    print_resultant_table();    // Print the resultant table with process details
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    print_group_averages();     // Print the averages of every group
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,165 @@
+// Streaming SVG renderer of Gantt charts shared by the scheduling programs
+//
+// The including file walks its own Gantt chart and passes every execution segment to render_gantt_segment, in time
+// order, between begin_gantt_drawing and end_gantt_drawing. Every pixel column is a bucket drawn in the colour of
+// the process that covers most of it in total, summed over all its segments in the column, and runs of buckets with
+// the same process are merged into one rectangle, so the output size is bounded by the width of the drawing and not
+// by the length of the schedule.
+// A column that several processes share also gets a min/max summary in a strip under the bar: the lowest and the
+// highest process ID that ran in it, so a burst shorter than a pixel is still visible next to the dominant process.
+// The including file defines MAX_PROCESS, the most processes that can share a column.
+
+#ifndef GANTT_RENDERER_H
+#define GANTT_RENDERER_H
+
+#include <stdio.h>
+
+#define SVG_WIDTH 1000  // Width of the drawn Gantt chart in pixels, one time bucket per pixel column
+#define SVG_ROW_HEIGHT 40  // Height of the drawn Gantt chart bar in pixels
+#define SVG_SUMMARY_HEIGHT 8  // Height of the strip under the bar summarizing the columns shared by several processes
+
+// Structure to represent the state of the Gantt chart renderer while it streams segments into the drawing
+typedef struct
+{
+    FILE *file;             // File the drawing is written to
+    double scale;           // Pixels per unit of time
+    int bucket;             // Pixel column currently being filled, -1 before the first segment
+    int bucket_count;       // Number of processes that ran in the current column
+    int bucket_ids[MAX_PROCESS];        // Process IDs that ran in the current column, in the order they first ran in it
+    double bucket_shares[MAX_PROCESS];  // Fraction of the current column covered by each of those processes
+    int rect_process_id;    // Process of the rectangle waiting to be written, -1 if there is none
+    int rect_start;         // First pixel column of that rectangle
+    int rect_end;           // Pixel column just past that rectangle
+} Gantt_Renderer;
+
+// Function to write the pending rectangle of the renderer, labelled with its process ID when it is wide enough
+static void flush_gantt_rect(Gantt_Renderer *renderer)
+{
+    if (renderer->rect_process_id == -1)
+        return;
+
+    fprintf(renderer->file, "<rect x=\"%d\" y=\"0\" width=\"%d\" height=\"%d\" fill=\"hsl(%d,60%%,65%%)\" stroke=\"black\"/>\n",
+        renderer->rect_start, renderer->rect_end - renderer->rect_start, SVG_ROW_HEIGHT, renderer->rect_process_id * 47 % 360);
+
+    if (renderer->rect_end - renderer->rect_start >= 30)
+        fprintf(renderer->file, "<text x=\"%d\" y=\"%d\" text-anchor=\"middle\">P%d</text>\n",
+            (renderer->rect_start + renderer->rect_end) / 2, SVG_ROW_HEIGHT / 2 + 5, renderer->rect_process_id);
+
+    renderer->rect_process_id = -1;
+}
+
+// Function to close the current pixel column, extending the pending rectangle if it continues the same process
+static void finish_gantt_bucket(Gantt_Renderer *renderer)
+{
+    if (renderer->bucket == -1)
+        return;
+
+    int dominant = 0, min_id = renderer->bucket_ids[0], max_id = renderer->bucket_ids[0];
+
+    // The column goes to the largest total share, a tie to the process that ran first in the column
+    for (int k = 1; k < renderer->bucket_count; k++)
+    {
+        if (renderer->bucket_shares[k] > renderer->bucket_shares[dominant])
+            dominant = k;
+        if (renderer->bucket_ids[k] < min_id)
+            min_id = renderer->bucket_ids[k];
+        if (renderer->bucket_ids[k] > max_id)
+            max_id = renderer->bucket_ids[k];
+    }
+
+    // Summarize a shared column by its lowest process ID in the upper half of the strip and its highest in the lower half
+    if (min_id != max_id)
+    {
+        fprintf(renderer->file, "<rect x=\"%d\" y=\"%d\" width=\"1\" height=\"%d\" fill=\"hsl(%d,60%%,45%%)\"/>\n",
+            renderer->bucket, SVG_ROW_HEIGHT + 1, SVG_SUMMARY_HEIGHT / 2, min_id * 47 % 360);
+        fprintf(renderer->file, "<rect x=\"%d\" y=\"%d\" width=\"1\" height=\"%d\" fill=\"hsl(%d,60%%,45%%)\"/>\n",
+            renderer->bucket, SVG_ROW_HEIGHT + 1 + SVG_SUMMARY_HEIGHT / 2, SVG_SUMMARY_HEIGHT / 2, max_id * 47 % 360);
+    }
+
+    if (renderer->rect_process_id != renderer->bucket_ids[dominant] || renderer->rect_end != renderer->bucket)
+    {
+        flush_gantt_rect(renderer);
+        renderer->rect_process_id = renderer->bucket_ids[dominant];
+        renderer->rect_start = renderer->bucket;
+    }
+
+    renderer->rect_end = renderer->bucket + 1;
+}
+
+// Function to add one execution segment to the drawing, segments must be added in time order
+static void render_gantt_segment(Gantt_Renderer *renderer, int process_id, int start, int end)
+{
+    double x = start * renderer->scale, x_end = end * renderer->scale;
+
+    // Visit every pixel column the segment overlaps, segments do not overlap so the total work is bounded by segments plus width
+    while (x < x_end)
+    {
+        int bucket = (x < SVG_WIDTH) ? (int)x : SVG_WIDTH - 1;
+        double next = (x_end < bucket + 1) ? x_end : bucket + 1;
+
+        if (bucket != renderer->bucket)
+        {
+            finish_gantt_bucket(renderer);
+            renderer->bucket = bucket;
+            renderer->bucket_count = 0;
+        }
+
+        // Add the piece to the share of its process in the column, a process runs in several pieces under Round Robin
+        int k = 0;
+        while (k < renderer->bucket_count && renderer->bucket_ids[k] != process_id)
+            k++;
+
+        if (k == renderer->bucket_count && k < MAX_PROCESS)
+        {
+            renderer->bucket_ids[k] = process_id;
+            renderer->bucket_shares[k] = 0;
+            renderer->bucket_count++;
+        }
+
+        if (k < renderer->bucket_count)
+            renderer->bucket_shares[k] += next - x;
+
+        if (next <= x)
+            break;  // The segment ends at the right edge of the drawing
+        x = next;
+    }
+}
+
+// Function to start a drawing of the given length of time, wrapped in a self-contained HTML page if requested
+static void begin_gantt_drawing(Gantt_Renderer *renderer, FILE *file, int end_time, int html)
+{
+    renderer->file = file;
+    renderer->scale = (double)SVG_WIDTH / end_time;
+    renderer->bucket = -1;
+    renderer->rect_process_id = -1;
+
+    if (html)
+        fprintf(file, "<!DOCTYPE html>\n<html>\n<head><meta charset=\"utf-8\"><title>Gantt Chart</title></head>\n<body>\n");
+
+    fprintf(file, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"-10 0 %d %d\" font-family=\"sans-serif\" font-size=\"12\">\n",
+        SVG_WIDTH + 20, SVG_ROW_HEIGHT + SVG_SUMMARY_HEIGHT + 20, SVG_WIDTH + 20, SVG_ROW_HEIGHT + SVG_SUMMARY_HEIGHT + 20);
+}
+
+// Function to finish the drawing with the time axis labels and close its file
+// Returns 0 on success and -1 if the drawing could not be written
+static int end_gantt_drawing(Gantt_Renderer *renderer, int end_time, int html)
+{
+    finish_gantt_bucket(renderer);
+    flush_gantt_rect(renderer);
+
+    fprintf(renderer->file, "<text x=\"0\" y=\"%d\">0</text>\n", SVG_ROW_HEIGHT + SVG_SUMMARY_HEIGHT + 15);
+    fprintf(renderer->file, "<text x=\"%d\" y=\"%d\" text-anchor=\"end\">%d</text>\n", SVG_WIDTH, SVG_ROW_HEIGHT + SVG_SUMMARY_HEIGHT + 15, end_time);
+    fprintf(renderer->file, "</svg>\n");
+
+    if (html)
+        fprintf(renderer->file, "</body>\n</html>\n");
+
+    int failed = ferror(renderer->file);
+
+    if (fclose(renderer->file) == EOF)
+        failed = 1;
+
+    return failed ? -1 : 0;
+}
+
+#endif
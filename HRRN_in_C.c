@@ -0,0 +1,394 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes entered interactively, a workload file may hold any number
+#define NEVER __LONG_LONG_MAX__  // Expiry time of a tournament that can never change
+
+// Structure to represent a process
+typedef struct
+{
+    int process_id;         // Unique ID for the process
+    int arrival_time;       // Arrival time of the process
+    int burst_time;         // Burst time (time required for execution)
+    int completion_time;    // Time at which the process finishes execution
+} Process;
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+Process *processes;     // Array of processes, allocated for MAX_PROCESS or for the processes of the workload file
+
+int *gantt_chart, I = 0;   // Array to store the order of processes in the Gantt chart and a counter variable
+
+int n;  // Global variable to store the number of processes
+
+// Reader of the --workload files, the priority column is not used
+#include "Workload_Reader.h"
+
+// Kinetic tournament tree over the ready processes, leaves hold process indices in arrival order
+// The response ratio (t - arrival + burst) / burst of every process is a line in the current time t, so each node
+// keeps the winner of its subtree together with the first time at which some match below it can change result.
+// Advancing the clock only replays the matches that have expired, instead of rescanning every waiting process
+int tree_size;           // Number of leaves of the tournament tree, a power of two not below the number of processes
+int *winner;            // Index of the process with the highest response ratio in the subtree, -1 if empty
+long long *expires;     // First time at which the winner of the subtree has to be recomputed
+
+// Function to allocate the processes, the Gantt chart and the tournament tree for count processes
+// Returns -1 if the memory is not available
+int allocate_processes(int count)
+{
+    for (tree_size = 1; tree_size < count; tree_size *= 2)
+        ;
+
+    processes = malloc(count * sizeof(Process));
+    gantt_chart = malloc(count * sizeof(int));
+    winner = malloc(2 * tree_size * sizeof(int));
+    expires = malloc(2 * tree_size * sizeof(long long));
+
+    return (processes == NULL || gantt_chart == NULL || winner == NULL || expires == NULL) ? -1 : 0;
+}
+
+// Function to read a workload file of any size, allocating the arrays for its processes
+// Returns the number of processes, -1 on error
+int load_large_workload(const char *path)
+{
+    long long count = count_workload_records(path);
+
+    if (count < 1 || count > __INT_MAX__ / 2 || allocate_processes((int)count) == -1)
+        return -1;
+
+    n = read_workload(path, (int)count, store_process);
+    return n;
+}
+
+// Function to check whether process a has a higher response ratio than process b at time t, ties go to the earlier arrival
+int beats(int a, int b, int t)
+{
+    long long ratio_a = (long long)(t - processes[a].arrival_time + processes[a].burst_time) * processes[b].burst_time;
+    long long ratio_b = (long long)(t - processes[b].arrival_time + processes[b].burst_time) * processes[a].burst_time;
+
+    if (ratio_a != ratio_b)
+        return ratio_a > ratio_b;
+
+    return a < b;
+}
+
+// Function to replay the match at a node at time t, using the winners of its two children
+void play_match(int node, int t)
+{
+    int left = winner[2 * node], right = winner[2 * node + 1];
+    long long certificate = NEVER;
+
+    expires[node] = (expires[2 * node] < expires[2 * node + 1]) ? expires[2 * node] : expires[2 * node + 1];
+
+    if (left == -1 || right == -1)
+    {
+        winner[node] = (left == -1) ? right : left;
+        return;
+    }
+
+    int best = beats(left, right, t) ? left : right, other = (best == left) ? right : left;
+    winner[node] = best;
+
+    // A process with a shorter burst gains ratio faster, so it overtakes the winner where their lines cross
+    if (processes[other].burst_time < processes[best].burst_time)
+    {
+        long long numerator = (long long)processes[other].arrival_time * processes[best].burst_time - (long long)processes[best].arrival_time * processes[other].burst_time;
+        long long denominator = processes[best].burst_time - processes[other].burst_time;
+
+        // Round the crossing time down, and never before the next time unit since the winner holds at t
+        certificate = numerator / denominator - (numerator % denominator < 0);
+        if (certificate <= t)
+            certificate = t + 1;
+    }
+
+    if (certificate < expires[node])
+        expires[node] = certificate;
+}
+
+// Function to bring the tournament below a node up to date at time t
+void advance_tournament(int node, int t)
+{
+    if (node >= tree_size || expires[node] > t)
+        return;
+
+    advance_tournament(2 * node, t);
+    advance_tournament(2 * node + 1, t);
+    play_match(node, t);
+}
+
+// Function to put a process into a leaf of the tournament, or empty the leaf with -1, and replay the matches above it
+void set_leaf(int index, int process, int t)
+{
+    int node = tree_size + index;
+
+    winner[node] = process;
+    expires[node] = NEVER;
+
+    for (node /= 2; node > 0; node /= 2)
+        play_match(node, t);
+}
+
+// Function to compare two processes for qsort by arrival time, equal arrivals keep their input order
+int compare_arrival(const void *a, const void *b)
+{
+    const Process *x = a, *y = b;
+
+    if (x->arrival_time != y->arrival_time)
+        return (x->arrival_time > y->arrival_time) - (x->arrival_time < y->arrival_time);
+
+    return (x->process_id > y->process_id) - (x->process_id < y->process_id);
+}
+
+// Function to perform Highest Response Ratio Next scheduling and calculate completion time, turnaround time and waiting time for each process
+void hrrn_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+
+    // Sort the processes based on their arrival time, in O(n log n) so that large workloads stay fast
+    qsort(processes, n, sizeof(Process), compare_arrival);
+
+    // Start with an empty tournament
+    for (int node = 1; node < 2 * tree_size; node++)
+    {
+        winner[node] = -1;
+        expires[node] = NEVER;
+    }
+
+    while (completed_processes < n)
+    {
+        // Bring the tournament up to date, then add every process that has arrived
+        advance_tournament(1, current_time);
+
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+        {
+            set_leaf(next_arrival, next_arrival, current_time);
+            next_arrival++;
+        }
+
+        // If no process is ready to execute, the CPU is idle until the next arrival, so jump straight to it
+        if (winner[1] == -1)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            continue;
+        }
+
+        // Run the process with the highest response ratio to completion
+        int next_process = winner[1];
+        set_leaf(next_process, -1, current_time);
+
+        current_time += processes[next_process].burst_time;
+        processes[next_process].completion_time = current_time;
+
+        completed_processes++;  // Increment the count of completed processes
+
+        // Store the process in the Gantt chart order array
+        gantt_chart[I] = next_process;
+        I++;
+    }
+}
+
+// Function to calculate average turnaround time
+float calculate_average_turnaround_time()
+{
+    long long total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate average waiting time
+float calculate_average_waiting_time()
+{
+    long long total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |\n");
+    printf("-------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i])
+        );
+
+    printf("-------------------------------------------------------------------------------------------------\n");
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0 && processes[gantt_chart[i - 1]].completion_time < processes[gantt_chart[i]].arrival_time)
+        {
+            printf("--");
+        }
+
+        printf("----------------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0 && processes[gantt_chart[i - 1]].completion_time < processes[gantt_chart[i]].arrival_time)
+        {
+            printf("    |");
+        }
+
+        printf("\tP%d\t|", processes[gantt_chart[i]].process_id);
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0 && processes[gantt_chart[i - 1]].completion_time < processes[gantt_chart[i]].arrival_time)
+        {
+            printf("--");
+        }
+
+        printf("----------------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0 && processes[gantt_chart[i - 1]].completion_time < processes[gantt_chart[i]].arrival_time)
+        {
+            printf("    %d", processes[gantt_chart[i]].arrival_time);
+        }
+
+        printf("\t\t%d", processes[gantt_chart[i]].completion_time);
+    }
+    printf("\n");
+}
+
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    const char *workload_path = NULL;   // Workload file to read instead of the interactive input, if requested
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_large_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of at least one process from %s.\n", workload_path);
+            return 1;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].burst_time <= 0)
+            {
+                printf("Burst time must be positive.\n");
+                return 1;
+            }
+        }
+    }
+    else
+    {
+        if (allocate_processes(MAX_PROCESS) == -1)
+        {
+            printf("Could not allocate the processes.\n");
+            return 1;
+        }
+
+        // Input the number of processes
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Ensure that the number of processes is within the allowed limit
+        if (n < 1 || n > MAX_PROCESS)
+        {
+            printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        // Input the arrival and burst times for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+
+            if (processes[i].burst_time <= 0)
+            {
+                printf("Burst time must be positive.\n");
+                return 1;
+            }
+        }
+    }
+
+    hrrn_scheduling();          // Perform the HRRN scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+
+    // A workload file may hold millions of processes, so only the averages are printed for it
+    if (workload_path == NULL)
+    {
+        print_gantt_chart();        // Print the Gantt chart
+
+        print_resultant_table();    // Print the resultant table with process details
+    }
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %f\n", calculate_average_waiting_time());
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,518 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sched.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+#define MAX_PROCESS 10         // Maximum number of processes that can be handled
+#define MAX_DECISIONS 100000   // Maximum number of dispatcher decisions whose latency is recorded
+
+// Policies the dispatcher can enforce
+enum { POLICY_ROUND_ROBIN, POLICY_SRTF, POLICY_PRIORITY };
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;              // Process ID (identifier)
+    int arrival_time;            // Time at which the process arrives in the ready queue
+    int burst_time;              // CPU burst time required by the process
+    int priority;                // Priority of the process (0 being the highest)
+    int completion_time;         // Simulated time at which the process finishes execution
+    double live_completion_time; // Measured time at which the worker of the process exited, in units of time
+    int remaining_time;          // Units of time the dispatcher still has to give the process
+    int done;                    // Set once the process has finished
+    pid_t worker;                // Child process that does the work of the process in live mode
+} Process;
+
+// Function to derive the simulated waiting time of a process from its simulated completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Function to derive the measured waiting time of a process from its measured completion time
+static inline double live_waiting_time(const Process *p)
+{
+    return p->live_completion_time - p->arrival_time - p->burst_time;
+}
+
+Process processes[MAX_PROCESS]; // Array of processes
+int n, q = 1;  // Number of processes and time quantum of Round Robin
+int policy = POLICY_ROUND_ROBIN;  // Policy enforced by the dispatcher
+
+// Dispatcher state, all in fixed arrays so a decision never allocates or takes a lock
+int ready_queue[MAX_PROCESS];   // Circular FIFO of ready processes for Round Robin
+int queue_head = 0, queue_count = 0;
+int next_arrival = 0;           // Index of the next process to arrive, the processes are sorted by arrival time
+int running = -1;               // Process given the CPU by the last decision, -1 if the CPU was idle
+int slice_used = 0;             // Units of time the running process has used of its quantum
+
+long long decision_latency[MAX_DECISIONS];  // Time taken by each live decision in nanoseconds
+int decisions = 0;              // Number of live decisions recorded
+long long missed_ticks = 0;     // Timer ticks that passed while the dispatcher was late
+
+// Function to return the monotonic clock in nanoseconds
+long long now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Function to reset the dispatcher before a run
+void reset_dispatcher()
+{
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].done = 0;
+    }
+
+    queue_head = queue_count = next_arrival = slice_used = 0;
+    running = -1;
+}
+
+// Function to move every process that has arrived by time t into the ready set
+void admit_arrivals(int t)
+{
+    while (next_arrival < n && processes[next_arrival].arrival_time <= t)
+    {
+        ready_queue[(queue_head + queue_count) % MAX_PROCESS] = next_arrival;
+        queue_count++;
+        next_arrival++;
+    }
+}
+
+// Function to choose the process that gets the CPU for the next unit of time, or -1 if none is ready
+// The same decision is used by the simulation and by the live dispatcher, so both enforce identical policies
+int choose_next()
+{
+    // A live worker that has been given its whole burst keeps the CPU until it exits, which the dispatcher notices at
+    // once; in the simulation such a process is already done
+    if (running != -1 && !processes[running].done && processes[running].remaining_time == 0)
+        return running;
+
+    if (policy == POLICY_ROUND_ROBIN)
+    {
+        // The running process keeps the CPU until its quantum is used up
+        if (running != -1 && !processes[running].done && slice_used < q)
+            return running;
+
+        // A pre-empted process goes to the back, behind the processes that arrived meanwhile
+        if (running != -1 && !processes[running].done)
+        {
+            ready_queue[(queue_head + queue_count) % MAX_PROCESS] = running;
+            queue_count++;
+        }
+
+        // Skip processes that finished while waiting in the queue
+        while (queue_count > 0 && processes[ready_queue[queue_head]].done)
+        {
+            queue_head = (queue_head + 1) % MAX_PROCESS;
+            queue_count--;
+        }
+
+        if (queue_count == 0)
+            return -1;
+
+        int next = ready_queue[queue_head];
+        queue_head = (queue_head + 1) % MAX_PROCESS;
+        queue_count--;
+        return next;
+    }
+
+    // SRTF and Priority pick the arrived process with the smallest key, the earliest arrival on ties
+    int best = -1;
+
+    for (int i = 0; i < next_arrival; i++)
+    {
+        if (processes[i].done)
+            continue;
+
+        int key = (policy == POLICY_SRTF) ? processes[i].remaining_time : processes[i].priority;
+        int best_key = (best == -1) ? 0 : ((policy == POLICY_SRTF) ? processes[best].remaining_time : processes[best].priority);
+
+        if (best == -1 || key < best_key)
+            best = i;
+    }
+
+    return best;
+}
+
+// Function to give the CPU to a process for the next unit of time, restarting its quantum on a switch
+void dispatch(int next)
+{
+    if (next != running)
+        slice_used = 0;
+
+    running = next;
+}
+
+// Function to simulate the policy one unit of time at a time and calculate the completion and waiting times
+void simulate()
+{
+    int current_time = 0, completed_processes = 0;
+
+    reset_dispatcher();
+
+    while (completed_processes < n)
+    {
+        admit_arrivals(current_time);
+        dispatch(choose_next());
+        current_time++;
+
+        if (running == -1)
+            continue;   // Idle unit of time
+
+        slice_used++;
+
+        if (--processes[running].remaining_time == 0)
+        {
+            processes[running].done = 1;
+            processes[running].completion_time = current_time;
+            completed_processes++;
+        }
+    }
+}
+
+// Function run by a worker: burn CPU until it has used burst_ms milliseconds of CPU time, then exit
+// It only accumulates CPU time while the dispatcher lets it run
+void worker_main(long long burst_ms)
+{
+    struct timespec ts;
+
+    for (;;)
+    {
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        if ((long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000 >= burst_ms)
+            _exit(0);
+    }
+}
+
+// Function to fork one stopped worker per process, all pinned to the given CPU core
+int start_workers(int cpu, int unit_ms)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    for (int i = 0; i < n; i++)
+    {
+        pid_t pid = fork();
+
+        if (pid == -1)
+            return -1;
+
+        if (pid == 0)
+        {
+            sched_setaffinity(0, sizeof(set), &set);
+            raise(SIGSTOP);     // Wait for the dispatcher to give the CPU
+            worker_main((long long)processes[i].burst_time * unit_ms);
+        }
+
+        // Make sure the worker is stopped before the clock starts
+        int status;
+        waitpid(pid, &status, WUNTRACED);
+        processes[i].worker = pid;
+    }
+
+    return 0;
+}
+
+// Function to run the workers under the policy in real time, one timer tick per unit of time
+// Records the measured completion and waiting times and the latency of every dispatcher decision
+// SIGCHLD is read through a signalfd polled together with the timer, so a finished worker is collected and the CPU
+// handed on as soon as it exits rather than at the next tick
+int run_live(int unit_ms)
+{
+    struct itimerspec tick = { { unit_ms / 1000, (long)(unit_ms % 1000) * 1000000 }, { unit_ms / 1000, (long)(unit_ms % 1000) * 1000000 } };
+    int timer = timerfd_create(CLOCK_MONOTONIC, 0), completed_processes = 0;
+    long long start;
+    int current_time = 0;
+    sigset_t child_signal, previous_mask;
+
+    if (timer == -1)
+        return -1;
+
+    // Block SIGCHLD so it is only delivered through the signalfd
+    sigemptyset(&child_signal);
+    sigaddset(&child_signal, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &child_signal, &previous_mask);
+
+    int children = signalfd(-1, &child_signal, 0);
+
+    if (children == -1)
+    {
+        close(timer);
+        sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+        return -1;
+    }
+
+    reset_dispatcher();
+    start = now_ns();
+    timerfd_settime(timer, 0, &tick, NULL);
+
+    while (completed_processes < n)
+    {
+        long long decision_start;
+        uint64_t expirations = 0;
+        int exited = 0;
+
+        // Decide at time 0 straight away, then at every tick and whenever a worker exits
+        if (decisions > 0)
+        {
+            struct pollfd events[2] = { { timer, POLLIN, 0 }, { children, POLLIN, 0 } };
+
+            if (poll(events, 2, -1) == -1)
+                break;
+
+            if (events[0].revents & POLLIN)
+            {
+                if (read(timer, &expirations, sizeof(expirations)) != sizeof(expirations))
+                    break;
+
+                missed_ticks += (long long)expirations - 1;
+            }
+
+            // Pending SIGCHLDs merge into one, so a single read clears them and waitpid below finds every exited worker
+            if (events[1].revents & POLLIN)
+            {
+                struct signalfd_siginfo info;
+
+                if (read(children, &info, sizeof(info)) != sizeof(info))
+                    break;
+            }
+        }
+
+        decision_start = now_ns();
+
+        // Charge the running process for the ticks it ran
+        if (running != -1)
+        {
+            int used = (expirations < (uint64_t)processes[running].remaining_time) ? (int)expirations : processes[running].remaining_time;
+            processes[running].remaining_time -= used;
+            slice_used += (int)expirations;
+        }
+        current_time += (int)expirations;
+
+        // Collect the workers that have finished their work
+        pid_t pid;
+        int status;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (processes[i].worker == pid)
+                {
+                    processes[i].done = 1;
+                    processes[i].live_completion_time = (double)(now_ns() - start) / (unit_ms * 1000000.0);
+                    completed_processes++;
+                    exited++;
+                }
+            }
+        }
+
+        // Stopping a worker raises SIGCHLD as well, which needs no new decision
+        if (decisions > 0 && expirations == 0 && exited == 0)
+            continue;
+
+        admit_arrivals(current_time);
+
+        int previous = running, next = choose_next();
+        dispatch(next);
+
+        // Enforce the decision: stop the process losing the CPU and continue the one getting it
+        if (next != previous)
+        {
+            if (previous != -1 && !processes[previous].done)
+                kill(processes[previous].worker, SIGSTOP);
+            if (next != -1)
+                kill(processes[next].worker, SIGCONT);
+        }
+
+        if (decisions < MAX_DECISIONS)
+            decision_latency[decisions++] = now_ns() - decision_start;
+    }
+
+    close(children);
+    close(timer);
+    sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+    return 0;
+}
+
+// Function to compare two latencies for qsort
+int compare_latency(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Function to print the latency of the dispatcher decisions
+void print_decision_latency()
+{
+    if (decisions == 0)
+        return;
+
+    qsort(decision_latency, decisions, sizeof(long long), compare_latency);
+
+    printf("\nDispatcher Decisions: %d (missed timer ticks: %lld)\n", decisions, missed_ticks);
+    printf("Decision Latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+        decision_latency[(decisions - 1) / 2] / 1000.0,
+        decision_latency[(99 * decisions + 99) / 100 - 1] / 1000.0,
+        decision_latency[decisions - 1] / 1000.0);
+}
+
+// Function to print the resultant table with the simulated and the measured times side by side
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-----------------------------------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |   Priority    |  Sim C . T    |   Sim W . T   |  Live C . T   |  Live W . T   |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%.2f\t|\t%.2f\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].priority,
+            processes[i].completion_time,
+            waiting_time(&processes[i]),
+            processes[i].live_completion_time,
+            live_waiting_time(&processes[i])
+        );
+
+    printf("-----------------------------------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    int unit_ms = 10;   // Length of one unit of time in milliseconds
+    int cpu = 0;        // CPU core the workers are pinned to
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--unit") == 0)
+        {
+            unit_ms = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--cpu") == 0)
+        {
+            cpu = atoi(argv[++i]);
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (unit_ms <= 0 || cpu < 0)
+    {
+        printf("The unit of time must be positive and the CPU core must not be negative.\n");
+        return 1;
+    }
+
+    // Input the number of processes and the policy from the user
+    printf("Enter the number of processes: ");
+    scanf("%d", &n);
+
+    // Ensure that the number of processes is within the allowed limit
+    if (n < 1 || n > MAX_PROCESS)
+    {
+        printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+        return 1;
+    }
+
+    printf("Enter the policy (0 for Round Robin, 1 for SRTF, 2 for Priority): ");
+    scanf("%d", &policy);
+
+    if (policy < POLICY_ROUND_ROBIN || policy > POLICY_PRIORITY)
+    {
+        printf("Policy must be 0, 1 or 2.\n");
+        return 1;
+    }
+
+    if (policy == POLICY_ROUND_ROBIN)
+    {
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        if (q <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+    }
+
+    // Input the arrival time, burst time and priority for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].process_id = i + 1;
+        printf("Enter the arrival time of P%d: ", i + 1);
+        scanf("%d", &processes[i].arrival_time);
+        printf("Enter the burst time of P%d: ", i + 1);
+        scanf("%d", &processes[i].burst_time);
+
+        if (processes[i].burst_time <= 0)
+        {
+            printf("Burst time must be positive.\n");
+            return 1;
+        }
+
+        if (policy == POLICY_PRIORITY)
+        {
+            printf("Enter the priority of P%d (0 being the highest): ", i + 1);
+            scanf("%d", &processes[i].priority);
+        }
+    }
+
+    // Sort the processes based on their arrival time using bubble sort
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n - i - 1; j++)
+        {
+            if (processes[j].arrival_time > processes[j + 1].arrival_time)
+            {
+                // Swap the processes if their arrival time is in the wrong order
+                Process temp = processes[j];
+                processes[j] = processes[j + 1];
+                processes[j + 1] = temp;
+            }
+        }
+    }
+
+    simulate();     // Calculate the theoretical completion and waiting times
+
+    fflush(stdout); // Keep buffered output out of the workers
+
+    if (start_workers(cpu, unit_ms) == -1 || run_live(unit_ms) == -1)
+    {
+        printf("Could not run the workers.\n");
+
+        for (int i = 0; i < n; i++)
+            if (processes[i].worker > 0)
+                kill(processes[i].worker, SIGKILL);
+        return 1;
+    }
+
+    print_resultant_table();    // Print the simulated and the measured times
+
+    print_decision_latency();   // Print the overhead of the dispatcher
+
+    return 0;   // Return 0 to indicate successful execution
+}
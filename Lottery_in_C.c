@@ -0,0 +1,414 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes entered interactively, a workload file may hold any number
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int tickets;           // Number of lottery tickets held by the process, its share of the CPU
+    int completion_time;   // Time at which the process finishes execution
+    int remaining_time;    // Remaining time for the process to execute
+} Process;
+
+// run_quantum, running the winner for one quantum like round_robin_scheduling does
+#include "Quantum_Step.h"
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
+Process *processes; // Array of processes, allocated for MAX_PROCESS or for the processes of the workload file
+int I = 0;  // Gantt chart tracker index
+int n, q;  // Number of processes and time quantum (slice of time given to each lottery winner)
+
+// Reader of the --workload files, the third column holds the tickets of each process
+#define WORKLOAD_PRIORITY_FIELD tickets
+#include "Workload_Reader.h"
+
+long long *fenwick;                     // Fenwick tree over the tickets of the ready processes, indexed from 1 in arrival order
+long long total_tickets = 0;            // Number of tickets held by the ready processes, may exceed the range of an int
+unsigned long long random_state;        // State of the splitmix64 stream the tickets are drawn from, set by --seed
+
+// Function to allocate the processes and the Fenwick tree for count processes
+// Returns -1 if the memory is not available
+int allocate_processes(int count)
+{
+    processes = malloc(count * sizeof(Process));
+    fenwick = calloc(count + 1, sizeof(long long));
+
+    return (processes == NULL || fenwick == NULL) ? -1 : 0;
+}
+
+// Function to read a workload file of any size, allocating the arrays for its processes
+// Returns the number of processes, -1 on error
+int load_large_workload(const char *path)
+{
+    long long count = count_workload_records(path);
+
+    if (count < 1 || count > __INT_MAX__ || allocate_processes((int)count) == -1)
+        return -1;
+
+    n = read_workload(path, (int)count, store_process);
+    return n;
+}
+
+// Function to return the next number of a splitmix64 random stream
+unsigned long long next_random(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Function to draw a ticket uniformly from 0 to total - 1
+// Draws below 2^64 mod total are rejected, so the remaining range is a whole number of copies of every ticket
+// and the remainder has no modulo bias
+long long draw_ticket(long long total)
+{
+    unsigned long long threshold = -(unsigned long long)total % (unsigned long long)total, value;
+
+    do
+    {
+        value = next_random(&random_state);
+    } while (value < threshold);
+
+    return (long long)(value % (unsigned long long)total);
+}
+
+// Function to add delta tickets to the process at the given index
+void fenwick_add(int index, long long delta)
+{
+    total_tickets += delta;
+
+    for (int i = index + 1; i <= n; i += i & -i)
+        fenwick[i] += delta;
+}
+
+// Function to find the index of the process holding the given ticket (counted from 0) in O(log n)
+int fenwick_find(long long ticket)
+{
+    int position = 0, step = 1;
+
+    while (2 * step <= n)
+        step *= 2;
+
+    // Descend the tree, skipping every subtree whose tickets all come before the winning one
+    for (; step > 0; step /= 2)
+    {
+        if (position + step <= n && fenwick[position + step] <= ticket)
+        {
+            position += step;
+            ticket -= fenwick[position];
+        }
+    }
+
+    return position;    // The tree is indexed from 1, so position is the 0-based index of the holder
+}
+
+// Function to compare two processes for qsort by arrival time, equal arrivals keep their input order
+int compare_arrival(const void *a, const void *b)
+{
+    const Process *x = a, *y = b;
+
+    if (x->arrival_time != y->arrival_time)
+        return (x->arrival_time > y->arrival_time) - (x->arrival_time < y->arrival_time);
+
+    return (x->process_id > y->process_id) - (x->process_id < y->process_id);
+}
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I < MAX_SLOTS)
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to perform Lottery Scheduling and calculate the completion time, turnaround time and waiting time
+// Every quantum goes to the holder of a randomly drawn ticket, so each process gets the CPU in proportion to its tickets
+void lottery_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+
+    // Initialize remaining time for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].completion_time = -1;
+    }
+
+    // Sort the processes based on their arrival time, in O(n log n) so that large workloads stay fast
+    qsort(processes, n, sizeof(Process), compare_arrival);
+
+    while (completed_processes < n)
+    {
+        // Give the tickets of every process that has arrived to the draw
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+        {
+            fenwick_add(next_arrival, processes[next_arrival].tickets);
+            next_arrival++;
+        }
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (total_tickets == 0)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            add_gantt_slot(-1, current_time);
+            continue;
+        }
+
+        int winner = fenwick_find(draw_ticket(total_tickets));
+
+        // Run the winner for one quantum, or less if it finishes earlier
+        if (run_quantum(&processes[winner], &current_time, q))
+        {
+            completed_processes++;
+            fenwick_add(winner, -processes[winner].tickets);    // A finished process leaves the draw
+        }
+
+        add_gantt_slot(processes[winner].process_id, current_time);
+    }
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    long long total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    long long total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |    Tickets    |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            processes[i].tickets
+        );
+
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    unsigned long long seed = 1;        // Seed of the lottery draws, a fixed default keeps runs reproducible
+    const char *workload_path = NULL;   // Workload file to read instead of the interactive input, if requested
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--seed") == 0)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    random_state = seed;
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_large_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of at least one process from %s.\n", workload_path);
+            return 1;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].tickets <= 0)
+            {
+                printf("Number of tickets must be positive.\n");
+                return 1;
+            }
+        }
+
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        if (q <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+    }
+    else
+    {
+        if (allocate_processes(MAX_PROCESS) == -1)
+        {
+            printf("Could not allocate the processes.\n");
+            return 1;
+        }
+
+        // Input the number of processes and the quantum number from the user
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Ensure that the number of processes is within the allowed limit
+        if (n < 1 || n > MAX_PROCESS)
+        {
+            printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        if (q <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+
+        // Input the arrival time, burst time and tickets for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+            printf("Enter the number of tickets of P%d: ", i + 1);
+            scanf("%d", &processes[i].tickets);
+
+            if (processes[i].tickets <= 0)
+            {
+                printf("Number of tickets must be positive.\n");
+                return 1;
+            }
+        }
+    }
+
+    lottery_scheduling();   // Perform the Lottery Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+
+    // A workload file may hold millions of processes, so only the averages are printed for it
+    if (workload_path == NULL)
+    {
+        print_gantt_chart();        // Print the Gantt chart
+
+        print_resultant_table();    // Print the resultant table with process details
+    }
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,234 @@
+// Monte Carlo mode shared by the scheduling programs
+//
+// Before including this header, the including file provides the process array processes and the process count n,
+// defines MONTE_CARLO_METRICS and declares:
+//   const char *metric_names[MONTE_CARLO_METRICS]   names of the metrics, in the order they are collected
+//   void replica_engine(double metrics[])           runs the engine on processes[0] to processes[n - 1], generated in
+//                                                   arrival order, and fills the metrics of the replica
+// monte_carlo runs the replicas in rounds in forked worker processes and prints the means and percentiles of the
+// metrics with their 95% confidence intervals.
+
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define MAX_REPLICAS 100000  // Maximum number of Monte Carlo replicas
+#define MAX_WORKERS 64  // Maximum number of worker processes running Monte Carlo replicas in parallel
+#define MIN_REPLICAS 30  // Replicas needed before the confidence intervals are used to stop early
+
+static double replica_results[MAX_REPLICAS][MONTE_CARLO_METRICS];  // Metrics of every finished Monte Carlo replica
+static double sorted_values[MAX_REPLICAS];  // Scratch copy of one metric over the replicas, sorted for percentiles
+
+// Structure of the message a worker sends back for every replica it ran
+typedef struct
+{
+    int replica;                            // Index of the replica
+    double metrics[MONTE_CARLO_METRICS];    // Metrics of the replica
+} Replica_Result;
+
+// Function to return the next number of a splitmix64 random stream
+static unsigned long long next_random(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Function to draw an exponentially distributed time with the given mean, rounded to whole units and at least minimum
+static int random_exponential(unsigned long long *state, double mean, int minimum)
+{
+    double uniform = (double)(next_random(state) >> 11) / 9007199254740992.0;  // Uniform in [0, 1)
+    int value = (int)(-mean * log(1.0 - uniform) + 0.5);
+
+    return (value < minimum) ? minimum : value;
+}
+
+// Function to generate the workload of one replica, run the engine on it and collect its metrics
+// Every replica has its own random stream derived from the seed, so results do not depend on which worker runs it
+static void run_replica(int replica, unsigned long long seed, double mean_interarrival, double mean_burst, double *metrics)
+{
+    unsigned long long state = seed ^ (0xD1B54A32D192ED03ULL * (unsigned long long)(replica + 1));
+    int arrival_time = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].process_id = i + 1;
+        processes[i].arrival_time = arrival_time;
+        processes[i].burst_time = random_exponential(&state, mean_burst, 1);
+        arrival_time += random_exponential(&state, mean_interarrival, 0);
+    }
+
+    replica_engine(metrics);
+}
+
+// Function to stop the first started workers after a failed start, closing their pipes and reaping them
+static void stop_replica_workers(const int *pipes, const pid_t *pids, int started)
+{
+    for (int w = 0; w < started; w++)
+    {
+        close(pipes[w]);
+        kill(pids[w], SIGKILL);
+        waitpid(pids[w], NULL, 0);
+    }
+}
+
+// Function to run the replicas first to last - 1 in parallel worker processes
+// Each worker is a forked copy of the program, so it has its own engine state and scratch memory
+static int run_replicas(int first, int last, int workers, unsigned long long seed, double mean_interarrival, double mean_burst)
+{
+    int pipes[MAX_WORKERS];
+    pid_t pids[MAX_WORKERS];
+    Replica_Result result;
+
+    fflush(stdout);     // Keep buffered output out of the workers
+
+    for (int w = 0; w < workers; w++)
+    {
+        int fds[2];
+
+        if (pipe(fds) == -1)
+        {
+            stop_replica_workers(pipes, pids, w);
+            return -1;
+        }
+
+        if ((pids[w] = fork()) == -1)
+        {
+            close(fds[0]);
+            close(fds[1]);
+            stop_replica_workers(pipes, pids, w);
+            return -1;
+        }
+
+        if (pids[w] == 0)
+        {
+            close(fds[0]);
+
+            // Run every workers-th replica and send its metrics back, one small message per replica
+            for (int r = first + w; r < last; r += workers)
+            {
+                result.replica = r;
+                run_replica(r, seed, mean_interarrival, mean_burst, result.metrics);
+                if (write(fds[1], &result, sizeof(result)) != (ssize_t)sizeof(result))
+                    _exit(1);
+            }
+
+            _exit(0);
+        }
+
+        close(fds[1]);
+        pipes[w] = fds[0];
+    }
+
+    // Merge the results of the workers
+    int received = 0;
+    for (int w = 0; w < workers; w++)
+    {
+        while (read(pipes[w], &result, sizeof(result)) == (ssize_t)sizeof(result))
+        {
+            memcpy(replica_results[result.replica], result.metrics, sizeof(result.metrics));
+            received++;
+        }
+
+        close(pipes[w]);
+        waitpid(pids[w], NULL, 0);
+    }
+
+    return (received == last - first) ? 0 : -1;
+}
+
+// Function to calculate the mean of a metric over the replicas and the half-width of its 95% confidence interval
+static double metric_mean(int replicas, int metric, double *half_width)
+{
+    double sum = 0, squares = 0;
+
+    for (int r = 0; r < replicas; r++)
+        sum += replica_results[r][metric];
+
+    double mean = sum / replicas;
+
+    for (int r = 0; r < replicas; r++)
+        squares += (replica_results[r][metric] - mean) * (replica_results[r][metric] - mean);
+
+    *half_width = (replicas > 1) ? 1.96 * sqrt(squares / (replicas - 1) / replicas) : 0;
+    return mean;
+}
+
+// Function to compare two values for qsort
+static int compare_values(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Function to print a percentile of the sorted values with its 95% confidence interval
+// The interval comes from the order statistics around the percentile, so it needs no assumption on the distribution
+static void print_percentile(int replicas, double p)
+{
+    double spread = 1.96 * sqrt(replicas * p * (1 - p));
+    int rank = (int)ceil(p * replicas) - 1, low = (int)floor(p * replicas - spread) - 1, high = (int)ceil(p * replicas + spread) - 1;
+
+    if (rank < 0) rank = 0;
+    if (low < 0) low = 0;
+    if (high > replicas - 1) high = replicas - 1;
+
+    printf(", p%d %.2f (%.2f - %.2f)", (int)(p * 100 + 0.5), sorted_values[rank], sorted_values[low], sorted_values[high]);
+}
+
+// Function to run Monte Carlo replicas in rounds until the 95% confidence interval of every mean is within the given
+// precision (relative to the mean) or the number of replicas is reached, then print the means and percentiles
+static int monte_carlo(int replicas, int workers, double precision, unsigned long long seed, double mean_interarrival, double mean_burst)
+{
+    int done = 0, round = (workers * 8 > MIN_REPLICAS) ? workers * 8 : MIN_REPLICAS, converged = 0;
+    double half_width;
+
+    while (done < replicas && !converged)
+    {
+        int last = (done + round < replicas) ? done + round : replicas;
+
+        if (run_replicas(done, last, workers, seed, mean_interarrival, mean_burst) == -1)
+            return -1;
+        done = last;
+
+        // Stop early once every interval is tight enough
+        converged = (done >= MIN_REPLICAS);
+        for (int m = 0; m < MONTE_CARLO_METRICS && converged; m++)
+        {
+            double mean = metric_mean(done, m, &half_width);
+            converged = (half_width <= precision * fabs(mean));
+        }
+    }
+
+    printf("\nMonte Carlo: %d replicas of %d processes on %d workers", done, n, workers);
+    if (converged && done < replicas)
+        printf(" (stopped early, every 95%% interval is within %.1f%% of its mean)", precision * 100);
+    printf("\n");
+
+    for (int m = 0; m < MONTE_CARLO_METRICS; m++)
+    {
+        double mean = metric_mean(done, m, &half_width);
+
+        for (int r = 0; r < done; r++)
+            sorted_values[r] = replica_results[r][m];
+        qsort(sorted_values, done, sizeof(double), compare_values);
+
+        printf("%s: mean %.2f (%.2f - %.2f)", metric_names[m], mean, mean - half_width, mean + half_width);
+        print_percentile(done, 0.5);
+        print_percentile(done, 0.95);
+        print_percentile(done, 0.99);
+        printf("\n");
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,394 @@
+#include <stdio.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes that can be handled
+#define MAX_CLASSES 8   // Maximum number of process classes, one ready queue each
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int class_id;          // Class of the process, 0 is the foreground class
+    int completion_time;   // Time at which the process finishes execution
+    int remaining_time;    // Remaining time for the process to execute
+    int slice_left;        // Time left in the current Round Robin quantum, 0 when a fresh quantum is due
+} Process;
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Structure to represent the ready queue of one class, a circular FIFO of process indices with O(1) operations
+typedef struct
+{
+    int round_robin;       // 1 if the class is scheduled by Round Robin, 0 for FCFS
+    int quantum;           // Time quantum of a Round Robin class
+    int share;             // Time units the class gets per cycle when classes share the CPU by time slice
+    int items[MAX_PROCESS];
+    int head;              // Position of the first process in items
+    int count;             // Number of processes in the queue
+} Class_Queue;
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
+Process processes[MAX_PROCESS]; // Array of processes
+Class_Queue classes[MAX_CLASSES]; // Array of class queues
+int I = 0;  // Gantt chart tracker index
+int n, number_of_classes;  // Number of processes and number of classes
+int time_slice_mode = 0;  // 0 for strict priority between classes, 1 for a time slice share per class
+unsigned int non_empty = 0;  // Bit c is set while the queue of class c holds a process
+
+// Function to add a process at the back of its class queue
+void push_back(int process)
+{
+    Class_Queue *queue = &classes[processes[process].class_id];
+
+    queue->items[(queue->head + queue->count) % MAX_PROCESS] = process;
+    queue->count++;
+    non_empty |= 1u << processes[process].class_id;
+}
+
+// Function to put a process back at the front of its class queue, used when it was interrupted before its turn ended
+void push_front(int process)
+{
+    Class_Queue *queue = &classes[processes[process].class_id];
+
+    queue->head = (queue->head + MAX_PROCESS - 1) % MAX_PROCESS;
+    queue->items[queue->head] = process;
+    queue->count++;
+    non_empty |= 1u << processes[process].class_id;
+}
+
+// Function to remove and return the process at the front of a class queue
+int pop_front(int class_id)
+{
+    Class_Queue *queue = &classes[class_id];
+    int process = queue->items[queue->head];
+
+    queue->head = (queue->head + 1) % MAX_PROCESS;
+    queue->count--;
+
+    if (queue->count == 0)
+        non_empty &= ~(1u << class_id);
+
+    return process;
+}
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I < MAX_SLOTS)
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to perform Multi-level Queue Scheduling and calculate the completion time, turnaround time and waiting time
+// Each class keeps its own queue and policy. Between classes, strict priority always serves the lowest non-empty class
+// (found in O(1) from the non_empty bit mask), while time slice mode gives the classes their share of the CPU in turn
+void multilevel_queue_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+    int current_class = 0, budget = classes[0].share;  // Class being served and its time left in this cycle (time slice mode)
+
+    // Initialize remaining time for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].slice_left = 0;
+    }
+
+    // Sort the processes based on their arrival time using bubble sort
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n - i - 1; j++)
+        {
+            if (processes[j].arrival_time > processes[j + 1].arrival_time)
+            {
+                // Swap the processes if their arrival time is in the wrong order
+                Process temp = processes[j];
+                processes[j] = processes[j + 1];
+                processes[j + 1] = temp;
+            }
+        }
+    }
+
+    while (completed_processes < n)
+    {
+        // Move every process that has arrived into its class queue
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+            push_back(next_arrival++);
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (non_empty == 0)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            add_gantt_slot(-1, current_time);
+            continue;
+        }
+
+        // Choose the class to serve
+        if (!time_slice_mode)
+        {
+            current_class = __builtin_ctz(non_empty);
+        }
+        else if (budget == 0 || classes[current_class].count == 0)
+        {
+            // Move on to the next class with work and give it a fresh share
+            do
+            {
+                current_class = (current_class + 1) % number_of_classes;
+            } while (classes[current_class].count == 0);
+
+            budget = classes[current_class].share;
+        }
+
+        int next_process = pop_front(current_class);
+        int run = processes[next_process].remaining_time;
+
+        // A Round Robin class runs a process for at most the rest of its quantum
+        if (classes[current_class].round_robin)
+        {
+            if (processes[next_process].slice_left == 0)
+                processes[next_process].slice_left = classes[current_class].quantum;
+
+            if (processes[next_process].slice_left < run)
+                run = processes[next_process].slice_left;
+        }
+
+        // In time slice mode the class cannot run past its share
+        if (time_slice_mode && budget < run)
+            run = budget;
+
+        // Under strict priority, stop at the next arrival so that a higher class can take over
+        if (!time_slice_mode && next_arrival < n && processes[next_arrival].arrival_time - current_time < run)
+            run = processes[next_arrival].arrival_time - current_time;
+
+        current_time += run;
+        processes[next_process].remaining_time -= run;
+        add_gantt_slot(processes[next_process].process_id, current_time);
+
+        if (time_slice_mode)
+            budget -= run;
+
+        if (classes[current_class].round_robin)
+            processes[next_process].slice_left -= run;
+
+        if (processes[next_process].remaining_time == 0)
+        {
+            // Update the completion time for the process
+            processes[next_process].completion_time = current_time;
+            completed_processes++;
+            continue;
+        }
+
+        // Processes arriving now queue up before the process that was just running
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+            push_back(next_arrival++);
+
+        // A used-up quantum sends the process to the back of its queue, any other interruption keeps its place at the front
+        if (classes[current_class].round_robin && processes[next_process].slice_left == 0)
+            push_back(next_process);
+        else
+            push_front(next_process);
+    }
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    int total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    int total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |     Class     |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            processes[i].class_id
+        );
+
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main()
+{
+    // Input the number of processes from the user
+    printf("Enter the number of processes: ");
+    scanf("%d", &n);
+
+    // Ensure that the number of processes is within the allowed limit
+    if (n < 1 || n > MAX_PROCESS)
+    {
+        printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+        return 1;
+    }
+
+    // Input the classes and how each of them is scheduled
+    printf("Enter the number of classes (0 being the foreground class): ");
+    scanf("%d", &number_of_classes);
+
+    if (number_of_classes < 1 || number_of_classes > MAX_CLASSES)
+    {
+        printf("Number of classes must be between 1 and %d.\n", MAX_CLASSES);
+        return 1;
+    }
+
+    printf("Enter the scheduling between classes (0 for strict priority, 1 for time slice): ");
+    scanf("%d", &time_slice_mode);
+
+    for (int c = 0; c < number_of_classes; c++)
+    {
+        printf("Enter the policy of class %d (0 for FCFS, 1 for Round Robin): ", c);
+        scanf("%d", &classes[c].round_robin);
+
+        if (classes[c].round_robin)
+        {
+            printf("Enter the quantum number of class %d: ", c);
+            scanf("%d", &classes[c].quantum);
+        }
+
+        if (time_slice_mode)
+        {
+            printf("Enter the time share of class %d per cycle: ", c);
+            scanf("%d", &classes[c].share);
+        }
+
+        if ((classes[c].round_robin && classes[c].quantum <= 0) || (time_slice_mode && classes[c].share <= 0))
+        {
+            printf("Quantum and time share must be positive.\n");
+            return 1;
+        }
+    }
+
+    // Input the arrival time, burst time and class for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].process_id = i + 1;
+        printf("Enter the arrival time of P%d: ", i + 1);
+        scanf("%d", &processes[i].arrival_time);
+        printf("Enter the burst time of P%d: ", i + 1);
+        scanf("%d", &processes[i].burst_time);
+        printf("Enter the class of P%d: ", i + 1);
+        scanf("%d", &processes[i].class_id);
+
+        if (processes[i].class_id < 0 || processes[i].class_id >= number_of_classes)
+        {
+            printf("Class must be between 0 and %d.\n", number_of_classes - 1);
+            return 1;
+        }
+    }
+
+    multilevel_queue_scheduling();  // Perform the Multi-level Queue Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+
+    print_gantt_chart();        // Print the Gantt chart
+
+    print_resultant_table();    // Print the resultant table with process details
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,957 @@
+#define _DEFAULT_SOURCE  // realpath, mkdtemp and clock_gettime are POSIX, declare them under -std=c11 as well
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "Reference_Oracle.h"
+
+#define MAX_PROCESS 10  // Maximum number of processes entered interactively
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+#define BENCHMARK_DECISIONS 200000  // Number of timed decisions per queue size in the benchmark
+#define VERIFY_MAX_JOBS 12  // Largest workload generated by the differential verification
+#define ENGINE_MAX_JOBS 10  // Largest workload the batch programs accept, their MAX_PROCESS
+#define ENGINE_MAX_COLUMNS 8  // Most columns in the binary resultant table of a batch program
+
+// Policies of the online scheduler
+enum { POLICY_SJF, POLICY_SRTF, POLICY_ROUND_ROBIN, POLICY_PRIORITY };
+
+// Online scheduler: jobs are submitted as they arrive, the clock is advanced by the caller, and the scheduler is asked
+// which job to run next. All state lives in the structure, so several schedulers can run side by side.
+// SJF, SRTF and Priority keep the ready jobs in a binary min-heap ordered by (key, job ID), so like the batch engines
+// they break ties in favour of the lower ID, and Round Robin keeps them in a circular FIFO. Every call costs O(1)
+// (advance_to, and everything under Round Robin) or O(log n) (submit and next_decision)
+typedef struct
+{
+    int policy;             // Policy used to choose the next job
+    int quantum;            // Time quantum of Round Robin
+    int capacity;           // Number of job IDs the scheduler can hold, IDs go from 0 to capacity - 1
+    int clock;              // Current time
+    int *remaining;         // Remaining time of every job
+    int *key;               // Key of every ready job in the heap: burst time, remaining time at submission or priority
+    int *queue;             // Heap of ready jobs, or the circular FIFO under Round Robin
+    int queue_size;         // Number of ready jobs
+    int queue_head;         // First job of the FIFO under Round Robin
+    int running;            // Job holding the CPU, -1 if the CPU is idle
+    int slice_used;         // Time the running job has used of its quantum under Round Robin
+    int last_completion;    // Time at which the most recently finished job completed
+} Scheduler;
+
+// Structure returned by next_decision: the job to run and until when, unless something is submitted earlier
+typedef struct
+{
+    int job;        // Job to run, -1 if no job is ready
+    int run_until;  // Time of the next decision: completion of the job or end of its quantum
+} Decision;
+
+// Function to create a scheduler for job IDs 0 to capacity - 1, all memory is allocated here once
+Scheduler *scheduler_create(int capacity, int policy, int quantum)
+{
+    Scheduler *s = calloc(1, sizeof(Scheduler));
+
+    if (s == NULL)
+        return NULL;
+
+    s->policy = policy;
+    s->quantum = quantum;
+    s->capacity = capacity;
+    s->running = -1;
+    s->remaining = malloc(capacity * sizeof(int));
+    s->key = malloc(capacity * sizeof(int));
+    s->queue = malloc(capacity * sizeof(int));
+
+    if (s->remaining == NULL || s->key == NULL || s->queue == NULL)
+    {
+        free(s->remaining);
+        free(s->key);
+        free(s->queue);
+        free(s);
+        return NULL;
+    }
+
+    return s;
+}
+
+// Function to free a scheduler
+void scheduler_destroy(Scheduler *s)
+{
+    free(s->remaining);
+    free(s->key);
+    free(s->queue);
+    free(s);
+}
+
+// Function to check whether job a must run before job b in the heap
+static inline int runs_before(const Scheduler *s, int a, int b)
+{
+    if (s->key[a] != s->key[b])
+        return s->key[a] < s->key[b];
+
+    return a < b;
+}
+
+// Function to make a job ready: append it to the FIFO, or add it to the heap with the key of the policy
+static void make_ready(Scheduler *s, int job, int key)
+{
+    if (s->policy == POLICY_ROUND_ROBIN)
+    {
+        s->queue[(s->queue_head + s->queue_size) % s->capacity] = job;
+        s->queue_size++;
+        return;
+    }
+
+    s->key[job] = key;
+
+    // Move the new job up until its parent runs before it
+    int i = s->queue_size++;
+    while (i > 0 && runs_before(s, job, s->queue[(i - 1) / 2]))
+    {
+        s->queue[i] = s->queue[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    s->queue[i] = job;
+}
+
+// Function to remove and return the first ready job
+static int take_ready(Scheduler *s)
+{
+    int top;
+
+    if (s->policy == POLICY_ROUND_ROBIN)
+    {
+        top = s->queue[s->queue_head];
+        s->queue_head = (s->queue_head + 1) % s->capacity;
+        s->queue_size--;
+        return top;
+    }
+
+    top = s->queue[0];
+    int last = s->queue[--s->queue_size], i = 0;
+
+    // Move the last job down from the root until both children run after it
+    while (2 * i + 1 < s->queue_size)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < s->queue_size && runs_before(s, s->queue[child + 1], s->queue[child]))
+            child++;
+
+        if (!runs_before(s, s->queue[child], last))
+            break;
+
+        s->queue[i] = s->queue[child];
+        i = child;
+    }
+
+    s->queue[i] = last;
+    return top;
+}
+
+// Function to submit a job that arrives at the current time, returns -1 if the job ID is out of range
+int scheduler_submit(Scheduler *s, int job, int burst_time, int priority)
+{
+    if (job < 0 || job >= s->capacity || burst_time <= 0)
+        return -1;
+
+    s->remaining[job] = burst_time;
+    make_ready(s, job, (s->policy == POLICY_PRIORITY) ? priority : burst_time);
+    return 0;
+}
+
+// Function to advance the clock to time t, letting the running job execute meanwhile
+// Returns the job that finished on the way, whose completion time is last_completion, or -1 if none did
+int scheduler_advance_to(Scheduler *s, int t)
+{
+    int elapsed = t - s->clock, finished = -1;
+
+    if (elapsed <= 0)
+        return -1;
+
+    if (s->running != -1)
+    {
+        int job = s->running, used = (s->remaining[job] < elapsed) ? s->remaining[job] : elapsed;
+
+        s->remaining[job] -= used;
+        s->slice_used += used;
+
+        // The CPU stays idle after a completion until the next decision
+        if (s->remaining[job] == 0)
+        {
+            s->last_completion = s->clock + used;
+            s->running = -1;
+            finished = job;
+        }
+    }
+
+    s->clock = t;
+    return finished;
+}
+
+// Function to decide which job runs from the current time on, and until when at the latest
+Decision scheduler_next_decision(Scheduler *s)
+{
+    Decision decision;
+    int job = s->running;
+
+    if (job != -1)
+    {
+        // SJF never pre-empts, and Round Robin only pre-empts at the end of the quantum
+        int keeps_cpu = (s->policy == POLICY_SJF) || (s->policy == POLICY_ROUND_ROBIN && s->slice_used < s->quantum);
+
+        if (!keeps_cpu)
+        {
+            // Put the running job back, with its current remaining time under SRTF
+            make_ready(s, job, (s->policy == POLICY_PRIORITY) ? s->key[job] : s->remaining[job]);
+            job = -1;
+        }
+    }
+
+    if (job == -1 && s->queue_size > 0)
+    {
+        job = take_ready(s);
+        s->slice_used = 0;
+    }
+
+    s->running = job;
+    decision.job = job;
+    decision.run_until = s->clock;
+
+    if (job != -1)
+    {
+        int left = s->remaining[job];
+
+        if (s->policy == POLICY_ROUND_ROBIN && s->quantum - s->slice_used < left)
+            left = s->quantum - s->slice_used;
+
+        decision.run_until = s->clock + left;
+    }
+
+    return decision;
+}
+
+// Structure to represent Process of the interactive demonstration
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int priority;          // Priority of the process (0 being the highest)
+    int completion_time;   // Time at which the process finishes execution
+} Process;
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
+Process processes[MAX_PROCESS]; // Array of processes
+int I = 0;  // Gantt chart tracker index
+int n;  // Number of processes
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I < MAX_SLOTS)
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to replay the entered processes through the online interface: submit every arrival, ask for a decision,
+// and advance the clock to the end of the decision or the next arrival, whichever comes first
+int online_scheduling(int policy, int quantum)
+{
+    Scheduler *s = scheduler_create(n, policy, quantum);
+    int completed_processes = 0, next_arrival = 0;
+
+    if (s == NULL)
+        return -1;
+
+    // Sort the processes based on their arrival time using bubble sort
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n - i - 1; j++)
+        {
+            if (processes[j].arrival_time > processes[j + 1].arrival_time)
+            {
+                // Swap the processes if their arrival time is in the wrong order
+                Process temp = processes[j];
+                processes[j] = processes[j + 1];
+                processes[j + 1] = temp;
+            }
+        }
+    }
+
+    while (completed_processes < n)
+    {
+        // Submit every process that has arrived, the job ID is the index in the sorted array
+        while (next_arrival < n && processes[next_arrival].arrival_time <= s->clock)
+        {
+            scheduler_submit(s, next_arrival, processes[next_arrival].burst_time, processes[next_arrival].priority);
+            next_arrival++;
+        }
+
+        Decision decision = scheduler_next_decision(s);
+        int until = decision.run_until;
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (decision.job == -1)
+        {
+            scheduler_advance_to(s, processes[next_arrival].arrival_time);
+            add_gantt_slot(-1, s->clock);
+            continue;
+        }
+
+        // An arrival is a new event, so decide again when it happens
+        if (next_arrival < n && processes[next_arrival].arrival_time < until)
+            until = processes[next_arrival].arrival_time;
+
+        int finished = scheduler_advance_to(s, until);
+        add_gantt_slot(processes[decision.job].process_id, s->clock);
+
+        if (finished != -1)
+        {
+            processes[finished].completion_time = s->last_completion;
+            completed_processes++;
+        }
+    }
+
+    scheduler_destroy(s);
+    return 0;
+}
+
+// Function to return the monotonic clock in nanoseconds
+long long now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Function to compare two latencies for qsort
+int compare_latency(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Function to measure the latency of next_decision for every policy with queues of 10k jobs up to max_jobs jobs
+// The queue is filled first, then every timed decision is followed by one completion or pre-emption and one new
+// submission, so the queue size stays at its starting size during the measurement
+int run_benchmark(int max_jobs)
+{
+    const char *names[] = { "SJF", "SRTF", "Round Robin", "Priority" };
+    long long *latency = malloc(BENCHMARK_DECISIONS * sizeof(long long));
+
+    if (latency == NULL)
+        return -1;
+
+    printf("%-12s %10s %12s %12s\n", "Policy", "Jobs", "p50 (ns)", "p99 (ns)");
+
+    for (int jobs = 10000; jobs <= max_jobs; jobs *= 10)
+    {
+        for (int policy = POLICY_SJF; policy <= POLICY_PRIORITY; policy++)
+        {
+            Scheduler *s = scheduler_create(jobs + BENCHMARK_DECISIONS, policy, 4);
+            unsigned int random = 12345;
+
+            if (s == NULL)
+            {
+                free(latency);
+                return -1;
+            }
+
+            for (int j = 0; j < jobs; j++)
+            {
+                random = random * 1103515245u + 12345u;
+                scheduler_submit(s, j, (int)(random >> 16) % 100 + 1, (int)(random >> 8) % 40);
+            }
+
+            for (int d = 0; d < BENCHMARK_DECISIONS; d++)
+            {
+                long long start = now_ns();
+                Decision decision = scheduler_next_decision(s);
+                latency[d] = now_ns() - start;
+
+                // Let the job run to its decision point, and keep the queue size steady with one new job
+                scheduler_advance_to(s, decision.run_until);
+                random = random * 1103515245u + 12345u;
+                scheduler_submit(s, jobs + d, (int)(random >> 16) % 100 + 1, (int)(random >> 8) % 40);
+            }
+
+            qsort(latency, BENCHMARK_DECISIONS, sizeof(long long), compare_latency);
+            printf("%-12s %10d %12lld %12lld\n", names[policy], jobs,
+                latency[BENCHMARK_DECISIONS / 2], latency[BENCHMARK_DECISIONS / 100 * 99]);
+
+            scheduler_destroy(s);
+        }
+    }
+
+    free(latency);
+    return 0;
+}
+
+// Function to replay jobs sorted by arrival time through the online interface, writing the completion time of job i
+// to completion[i]. This is the loop of online_scheduling on plain arrays, without the Gantt chart
+int replay_jobs(int policy, int quantum, int n_jobs, const int *arrival, const int *burst, const int *priority, int *completion)
+{
+    Scheduler *s = scheduler_create(n_jobs, policy, quantum);
+    int completed_jobs = 0, next_arrival = 0;
+
+    if (s == NULL)
+        return -1;
+
+    while (completed_jobs < n_jobs)
+    {
+        while (next_arrival < n_jobs && arrival[next_arrival] <= s->clock)
+        {
+            scheduler_submit(s, next_arrival, burst[next_arrival], priority[next_arrival]);
+            next_arrival++;
+        }
+
+        Decision decision = scheduler_next_decision(s);
+        int until = decision.run_until;
+
+        if (decision.job == -1)
+        {
+            scheduler_advance_to(s, arrival[next_arrival]);
+            continue;
+        }
+
+        if (next_arrival < n_jobs && arrival[next_arrival] < until)
+            until = arrival[next_arrival];
+
+        int finished = scheduler_advance_to(s, until);
+
+        if (finished != -1)
+        {
+            completion[finished] = s->last_completion;
+            completed_jobs++;
+        }
+    }
+
+    scheduler_destroy(s);
+    return 0;
+}
+
+// Function to generate jobs sorted by arrival time: a job arrives together with the previous one, shortly after it,
+// or after a gap long enough to leave the CPU idle. Small bursts and priorities make equal keys common
+void generate_jobs(unsigned int *random, int n_jobs, int *arrival, int *burst, int *priority)
+{
+    int t = 0;
+
+    for (int j = 0; j < n_jobs; j++)
+    {
+        *random = *random * 1103515245u + 12345u;
+        int kind = (*random >> 16) % 8;
+
+        if (j > 0 && kind >= 3)
+            t += (kind == 7) ? 10 + (int)(*random >> 8) % 30 : (kind - 2);
+
+        *random = *random * 1103515245u + 12345u;
+        arrival[j] = t;
+        burst[j] = (int)(*random >> 16) % 8 + 1;
+        priority[j] = (int)(*random >> 8) % 4;
+    }
+}
+
+// Checks of the differential verification. Each has a reference engine and is run through the online scheduler, the
+// batch program, or both. The online scheduler has no FCFS or non-preemptive Priority policy, and its Round Robin
+// serves a FIFO while Round_Robin_in_C.c sweeps the processes in arrival order, so those are only checked on one side
+enum { CHECK_FCFS, CHECK_SJF, CHECK_SRTF, CHECK_PRIORITY, CHECK_NON_PREEMPTIVE_PRIORITY, CHECK_ROUND_ROBIN,
+    CHECK_ROUND_ROBIN_FIFO, CHECKS };
+
+const char *check_names[CHECKS] = { "FCFS", "SJF", "SRTF", "Priority", "Non-Preemptive Priority", "Round Robin",
+    "Round Robin FIFO" };
+const int check_policies[CHECKS] = { -1, POLICY_SJF, POLICY_SRTF, POLICY_PRIORITY, -1, -1, POLICY_ROUND_ROBIN };  // Online policy, -1 for none
+const char *check_programs[CHECKS] = { "FCFS_in_C", "SJF_in_C", "SRTF_in_C", "Priority_Preemptive_in_C",
+    "Priority_Non_Preemptive_in_C", "Round_Robin_in_C", NULL };  // Batch program, NULL for none
+
+// Function to run the reference engine of a check
+void run_reference(int check, int quantum, int n_jobs, const int *arrival, const int *burst, const int *priority, int *completion)
+{
+    switch (check)
+    {
+        case CHECK_FCFS: reference_fcfs(n_jobs, arrival, burst, completion); break;
+        case CHECK_SJF: reference_non_preemptive(n_jobs, arrival, burst, NULL, completion); break;
+        case CHECK_SRTF: reference_preemptive(n_jobs, arrival, burst, NULL, completion); break;
+        case CHECK_PRIORITY: reference_preemptive(n_jobs, arrival, burst, priority, completion); break;
+        case CHECK_NON_PREEMPTIVE_PRIORITY: reference_non_preemptive(n_jobs, arrival, burst, priority, completion); break;
+        case CHECK_ROUND_ROBIN: reference_round_robin(n_jobs, arrival, burst, quantum, completion); break;
+        default: reference_round_robin_fifo(n_jobs, arrival, burst, quantum, completion); break;
+    }
+}
+
+// Function to run the batch program of a check on the jobs, writing the completion time of job i to completion[i]
+// The program runs in the scratch directory, reading the jobs with --workload and the quantum from its standard input,
+// and writes its resultant table with --binary. Its checkpoint file, if any, stays in that directory too
+// Returns -1 if the program cannot be run, fails, or writes a table that does not hold every job once
+int run_engine(int check, const char *engines, const char *scratch, int quantum, int n_jobs, const int *arrival,
+    const int *burst, const int *priority, int *completion)
+{
+    char path[4096];
+    int rows[ENGINE_MAX_JOBS * ENGINE_MAX_COLUMNS];
+
+    // Write the jobs as raw workload records and the quantum as the input
+    snprintf(path, sizeof(path), "%s/workload", scratch);
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL)
+        return -1;
+
+    for (int j = 0; j < n_jobs; j++)
+    {
+        int record[3] = { arrival[j], burst[j], priority[j] };
+        fwrite(record, sizeof(int), 3, file);
+    }
+
+    if (fclose(file) == EOF)
+        return -1;
+
+    snprintf(path, sizeof(path), "%s/input", scratch);
+    file = fopen(path, "w");
+
+    if (file == NULL)
+        return -1;
+
+    fprintf(file, "%d\n", quantum);
+
+    if (fclose(file) == EOF)
+        return -1;
+
+    snprintf(path, sizeof(path), "%s/%s", engines, check_programs[check]);
+    fflush(stdout);     // Keep buffered output out of the program
+
+    pid_t pid = fork();
+    int status;
+
+    if (pid == -1)
+        return -1;
+
+    if (pid == 0)
+    {
+        if (chdir(scratch) == -1 || freopen("input", "r", stdin) == NULL || freopen("/dev/null", "w", stdout) == NULL)
+            _exit(127);
+
+        execl(path, path, "--workload", "workload", "--binary", "results", (char *)NULL);
+        _exit(127);
+    }
+
+    if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+
+    // The row width differs between the programs, so derive the number of columns from the size of the table
+    snprintf(path, sizeof(path), "%s/results", scratch);
+    file = fopen(path, "rb");
+
+    if (file == NULL)
+        return -1;
+
+    int values = (int)fread(rows, sizeof(int), ENGINE_MAX_JOBS * ENGINE_MAX_COLUMNS, file);
+    fclose(file);
+    remove(path);
+
+    int columns = values / n_jobs;
+
+    if (columns < 4 || values != columns * n_jobs)
+        return -1;
+
+    // Every table starts with the process ID, which is the position in the workload plus one, and has the completion
+    // time in its fourth column
+    for (int j = 0; j < n_jobs; j++)
+        completion[j] = -1;
+
+    for (int r = 0; r < n_jobs; r++)
+    {
+        int job = rows[r * columns] - 1;
+
+        if (job < 0 || job >= n_jobs || completion[job] != -1)
+            return -1;
+
+        completion[job] = rows[r * columns + 3];
+    }
+
+    return 0;
+}
+
+// Function to print a workload with the completion times of the reference and of the engine checked against it
+void print_disagreement(int check, const char *engine, int quantum, int n_jobs, const int *arrival, const int *burst,
+    const int *priority, const int *expected, const int *actual)
+{
+    if (check == CHECK_ROUND_ROBIN || check == CHECK_ROUND_ROBIN_FIFO)
+        printf("%s (%s, quantum %d) differs from its reference on this workload:\n", check_names[check], engine, quantum);
+    else
+        printf("%s (%s) differs from its reference on this workload:\n", check_names[check], engine);
+
+    printf("%-6s %8s %8s %8s %10s %10s\n", "Job", "A.T", "B.T", "Prio", "Expected", "Actual");
+
+    for (int j = 0; j < n_jobs; j++)
+        printf("%-6d %8d %8d %8d %10d %10d\n", j, arrival[j], burst[j], priority[j], expected[j], actual[j]);
+}
+
+// Function to check the online scheduler, and the batch programs in the engines directory unless it is NULL, against
+// the reference engines on random workloads of up to VERIFY_MAX_JOBS jobs (ENGINE_MAX_JOBS for the programs), then
+// time the reference and the online scheduler on larger workloads and report the speedup
+// Returns 1 at the first disagreement, after printing the workload that shows it, or if a program cannot be run
+int run_verification(int workloads, const char *engines)
+{
+    static int arrival[VERIFY_MAX_JOBS * 1000], burst[VERIFY_MAX_JOBS * 1000], priority[VERIFY_MAX_JOBS * 1000];
+    static int expected[VERIFY_MAX_JOBS * 1000], actual[VERIFY_MAX_JOBS * 1000];
+    unsigned int random = 2024;
+    char scratch[] = "/tmp/oracle_XXXXXX";
+
+    char *directory = NULL;     // Absolute path of the engines directory, since the programs run in the scratch directory
+    int failed = 0;
+
+    if (engines != NULL)
+    {
+        directory = realpath(engines, NULL);
+
+        if (directory == NULL || mkdtemp(scratch) == NULL)
+        {
+            printf("Could not find %s or create a scratch directory for the programs.\n", engines);
+            free(directory);
+            return 1;
+        }
+    }
+
+    for (int w = 0; w < workloads && !failed; w++)
+    {
+        random = random * 1103515245u + 12345u;
+        int n_jobs = (int)(random >> 16) % VERIFY_MAX_JOBS + 1;
+        int quantum = (int)(random >> 8) % 4 + 1;
+
+        generate_jobs(&random, n_jobs, arrival, burst, priority);
+
+        for (int check = 0; check < CHECKS && !failed; check++)
+        {
+            run_reference(check, quantum, n_jobs, arrival, burst, priority, expected);
+
+            if (check_policies[check] != -1)
+            {
+                replay_jobs(check_policies[check], quantum, n_jobs, arrival, burst, priority, actual);
+
+                if (memcmp(expected, actual, n_jobs * sizeof(int)) != 0)
+                {
+                    print_disagreement(check, "online", quantum, n_jobs, arrival, burst, priority, expected, actual);
+                    failed = 1;
+                }
+            }
+
+            if (!failed && engines != NULL && check_programs[check] != NULL && n_jobs <= ENGINE_MAX_JOBS)
+            {
+                if (run_engine(check, directory, scratch, quantum, n_jobs, arrival, burst, priority, actual) == -1)
+                {
+                    printf("Could not run %s/%s on a workload.\n", engines, check_programs[check]);
+                    failed = 1;
+                }
+                else if (memcmp(expected, actual, n_jobs * sizeof(int)) != 0)
+                {
+                    print_disagreement(check, check_programs[check], quantum, n_jobs, arrival, burst, priority, expected, actual);
+                    failed = 1;
+                }
+            }
+        }
+    }
+
+    if (engines != NULL)
+    {
+        char path[4096];
+
+        snprintf(path, sizeof(path), "%s/workload", scratch);
+        remove(path);
+        snprintf(path, sizeof(path), "%s/input", scratch);
+        remove(path);
+        rmdir(scratch);
+        free(directory);
+    }
+
+    if (failed)
+        return 1;
+
+    printf("%d random workloads: the online scheduler matches the references for SJF, SRTF, Priority and Round Robin FIFO.\n", workloads);
+    if (engines != NULL)
+        printf("The programs in %s match them for FCFS, SJF, SRTF, Priority, Non-Preemptive Priority and Round Robin.\n", engines);
+    else
+        printf("The programs were not checked, pass --engines DIR to run them.\n");
+
+    printf("\n%-18s %8s %16s %16s %10s\n", "Policy", "Jobs", "Reference (ms)", "Online (ms)", "Speedup");
+
+    // The larger workloads are checked too, so the timings always compare two runs with the same result
+    for (int n_jobs = VERIFY_MAX_JOBS * 250; n_jobs <= VERIFY_MAX_JOBS * 1000; n_jobs *= 2)
+    {
+        generate_jobs(&random, n_jobs, arrival, burst, priority);
+
+        for (int check = 0; check < CHECKS; check++)
+        {
+            if (check_policies[check] == -1)
+                continue;
+
+            long long start = now_ns();
+            run_reference(check, 4, n_jobs, arrival, burst, priority, expected);
+            long long reference_ns = now_ns() - start;
+
+            start = now_ns();
+            replay_jobs(check_policies[check], 4, n_jobs, arrival, burst, priority, actual);
+            long long online_ns = now_ns() - start;
+
+            if (memcmp(expected, actual, n_jobs * sizeof(int)) != 0)
+            {
+                print_disagreement(check, "online", 4, n_jobs, arrival, burst, priority, expected, actual);
+                return 1;
+            }
+
+            printf("%-18s %8d %16.2f %16.2f %9.2fx\n", check_names[check], n_jobs, reference_ns / 1e6, online_ns / 1e6,
+                (double)reference_ns / (online_ns > 0 ? online_ns : 1));
+        }
+    }
+
+    return 0;
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    int total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    int total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |   Priority    |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            processes[i].priority
+        );
+
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    int benchmark = 0;              // Set by --benchmark
+    int max_jobs = 10000000;        // Largest queue size measured by the benchmark
+    int verify = 0;                 // Number of random workloads checked by --verify, 0 to schedule entered processes
+    const char *engines = NULL;     // Directory of the compiled batch programs checked by --verify, set by --engines
+    int policy, quantum = 1;
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--benchmark") == 0)
+        {
+            benchmark = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--max-jobs") == 0)
+        {
+            max_jobs = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--engines") == 0)
+        {
+            engines = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--verify") == 0)
+        {
+            verify = atoi(argv[++i]);
+
+            if (verify <= 0)
+            {
+                printf("--verify needs a positive number of workloads.\n");
+                return 1;
+            }
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Benchmark mode: measure the decision latency instead of scheduling an entered workload
+    if (benchmark)
+    {
+        if (run_benchmark(max_jobs) == -1)
+        {
+            printf("Could not allocate the benchmark queues.\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Verification mode: compare the online scheduler with the reference engines instead of scheduling a workload
+    if (verify)
+        return run_verification(verify, engines);
+
+    // Input the number of processes and the policy from the user
+    printf("Enter the number of processes: ");
+    scanf("%d", &n);
+
+    // Ensure that the number of processes is within the allowed limit
+    if (n < 1 || n > MAX_PROCESS)
+    {
+        printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+        return 1;
+    }
+
+    printf("Enter the policy (0 for SJF, 1 for SRTF, 2 for Round Robin, 3 for Priority): ");
+    scanf("%d", &policy);
+
+    if (policy < POLICY_SJF || policy > POLICY_PRIORITY)
+    {
+        printf("Policy must be between 0 and 3.\n");
+        return 1;
+    }
+
+    if (policy == POLICY_ROUND_ROBIN)
+    {
+        printf("Enter the quantum number: ");
+        scanf("%d", &quantum);
+
+        if (quantum <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+    }
+
+    // Input the arrival time, burst time and priority for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].process_id = i + 1;
+        printf("Enter the arrival time of P%d: ", i + 1);
+        scanf("%d", &processes[i].arrival_time);
+        printf("Enter the burst time of P%d: ", i + 1);
+        scanf("%d", &processes[i].burst_time);
+
+        if (processes[i].burst_time <= 0)
+        {
+            printf("Burst time must be positive.\n");
+            return 1;
+        }
+
+        processes[i].priority = 0;
+        if (policy == POLICY_PRIORITY)
+        {
+            printf("Enter the priority of P%d (0 being the highest): ", i + 1);
+            scanf("%d", &processes[i].priority);
+        }
+    }
+
+    if (online_scheduling(policy, quantum) == -1)    // Replay the processes through the online scheduler
+    {
+        printf("Could not allocate the scheduler.\n");
+        return 1;
+    }
+
+    print_gantt_chart();        // Print the Gantt chart
+
+    print_resultant_table();    // Print the resultant table with process details
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,189 @@
+// Pre-emptive scheduling engine shared by SRTF_in_C.c and Priority_Preemptive_in_C.c
+//
+// This header is a compile-time template. Before including it, define:
+//   PREEMPTIVE_ENGINE_NAME      name of the engine function to generate
+//   PREEMPTIVE_ENGINE_KEY(i)    key of process i that the engine minimizes at every unit of time
+// and optionally, to change the policy or where its measurements go:
+//   PREEMPTIVE_ENGINE_BEFORE(i, best)         nonzero if arrived process i is picked over the best one found so far,
+//                                             best is -1 before the first; default a strictly smaller key, so
+//                                             ties go to the earliest arrival
+//   PREEMPTIVE_ENGINE_PREEMPTS(running, i)    nonzero if process i takes the CPU from the unfinished process that
+//                                             ran in the previous unit of time; default always
+//   PREEMPTIVE_ENGINE_COUNT(counter, amount)  adds to a counter of the Stats structure; default STAT_ADD
+//   PREEMPTIVE_ENGINE_TIMER_START(timer)      starts a timer of the Stats structure; default STAT_TIMER_START
+//   PREEMPTIVE_ENGINE_TIMER_STOP(timer)       stops it; default STAT_TIMER_STOP
+//   PREEMPTIVE_ENGINE_BUSY(start, end)        records that the CPU was busy from start to end; default telemetry_busy
+//   PREEMPTIVE_ENGINE_COMPLETION(time)        records a completion at time; default telemetry_completion
+//
+// The including file provides:
+//   Process processes[], int n    the processes, with process_id, arrival_time, burst_time, remaining_time,
+//                                 completion_time and first_run_time fields
+//   add_gantt_slot(id, time)      records that process id (-1 for idle) ran until time
+//   resumed, checkpoint_time, checkpoint_completed_processes
+//                                 set by the program when the run continues from a checkpoint
+//   save_checkpoint(time, done), CHECKPOINT_INTERVAL, finish_checkpoints()
+//                                 save_checkpoint is offered the state every CHECKPOINT_INTERVAL steps, and
+//                                 finish_checkpoints removes the checkpoint when the run ends (Checkpoint_Writer.h)
+//   the STAT_ macros of the Stats structure and the telemetry hooks of Telemetry.h, unless the sink is replaced
+//
+// Every parameter is expanded in place, so each engine compiles to its own loop without function pointers or
+// policy branches. The header has no include guard and undefines its parameters at the end, so one file can
+// instantiate it several times with different parameters.
+
+#ifndef PREEMPTIVE_ENGINE_BEFORE
+#define PREEMPTIVE_ENGINE_BEFORE(i, best) ((best) == -1 || PREEMPTIVE_ENGINE_KEY(i) < PREEMPTIVE_ENGINE_KEY(best))
+#endif
+#ifndef PREEMPTIVE_ENGINE_PREEMPTS
+#define PREEMPTIVE_ENGINE_PREEMPTS(running, i) 1
+#endif
+#ifndef PREEMPTIVE_ENGINE_COUNT
+#define PREEMPTIVE_ENGINE_COUNT(counter, amount) STAT_ADD(counter, amount)
+#endif
+#ifndef PREEMPTIVE_ENGINE_TIMER_START
+#define PREEMPTIVE_ENGINE_TIMER_START(timer) STAT_TIMER_START(timer)
+#endif
+#ifndef PREEMPTIVE_ENGINE_TIMER_STOP
+#define PREEMPTIVE_ENGINE_TIMER_STOP(timer) STAT_TIMER_STOP(timer)
+#endif
+#ifndef PREEMPTIVE_ENGINE_BUSY
+#define PREEMPTIVE_ENGINE_BUSY(start, end) telemetry_busy(start, end)
+#endif
+#ifndef PREEMPTIVE_ENGINE_COMPLETION
+#define PREEMPTIVE_ENGINE_COMPLETION(time) telemetry_completion(time)
+#endif
+
+void PREEMPTIVE_ENGINE_NAME()
+{
+    int current_time = 0, completed_processes = 0, steps = 0;  // Track the current time and completed processes
+    int running = -1;   // Unfinished process that ran in the previous unit of time, -1 if there is none
+
+    // When resuming, the processes are already initialized and sorted, so continue from the restored clock
+    if (resumed)
+    {
+        current_time = checkpoint_time;
+        completed_processes = checkpoint_completed_processes;
+    }
+    else
+    {
+        // Initialize remaining time for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].remaining_time = processes[i].burst_time;
+            processes[i].completion_time = -1;
+            processes[i].first_run_time = -1;
+        }
+
+        PREEMPTIVE_ENGINE_TIMER_START(sort_time);
+
+        // Sort the processes based on their arrival time using bubble sort
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n - i - 1; j++)
+            {
+                if (processes[j].arrival_time > processes[j + 1].arrival_time)
+                {
+                    // Swap the processes if their arrival time is in the wrong order
+                    Process temp = processes[j];
+                    processes[j] = processes[j + 1];
+                    processes[j + 1] = temp;
+                    PREEMPTIVE_ENGINE_COUNT(sort_swaps, 1);
+                }
+            }
+        }
+
+        PREEMPTIVE_ENGINE_TIMER_STOP(sort_time);
+    }
+
+    PREEMPTIVE_ENGINE_TIMER_START(schedule_time);
+
+    // Perform the scheduling
+    while (completed_processes < n)
+    {
+        PREEMPTIVE_ENGINE_COUNT(events, 1);
+
+        // Periodically save the engine state so an interrupted run can be resumed
+        if (++steps % CHECKPOINT_INTERVAL == 0)
+            save_checkpoint(current_time, completed_processes);
+
+        int next_process = -1;
+
+        // Find the arrived process that the policy ranks first, the processes are scanned in arrival order
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].arrival_time <= current_time && processes[i].remaining_time > 0 && PREEMPTIVE_ENGINE_BEFORE(i, next_process))
+            {
+                next_process = i;
+            }
+        }
+        PREEMPTIVE_ENGINE_COUNT(scanned, n);
+
+        // If no process is found, the CPU is idle until the next arrival, so jump straight to it
+        if (next_process == -1)
+        {
+            int next_arrival = __INT_MAX__;
+
+            // The processes are sorted by arrival time, so the first unfinished one arrives next
+            for (int i = 0; i < n; i++)
+            {
+                if (processes[i].remaining_time > 0)
+                {
+                    next_arrival = processes[i].arrival_time;
+                    break;
+                }
+            }
+
+            // Represent the whole idle period as a single slot in the Gantt chart, -1 being the placeholder for idle time
+            add_gantt_slot(-1, next_arrival);
+            current_time = next_arrival;
+            PREEMPTIVE_ENGINE_COUNT(idle_jumps, 1);
+            continue;
+        }
+
+        // Keep the running process unless the policy lets the chosen one pre-empt it
+        if (running != -1 && running != next_process && !PREEMPTIVE_ENGINE_PREEMPTS(running, next_process))
+            next_process = running;
+
+        PREEMPTIVE_ENGINE_COUNT(dispatches, 1);
+
+        // Record the first dispatch of the process for its response time
+        if (processes[next_process].first_run_time == -1)
+        {
+            processes[next_process].first_run_time = current_time;
+        }
+
+        // Update the remaining time for the process
+        processes[next_process].remaining_time--;
+        running = next_process;
+
+        // Update the current time
+        current_time++;
+        PREEMPTIVE_ENGINE_BUSY(current_time - 1, current_time);
+
+        // Update the completion time for the process
+        if (processes[next_process].remaining_time == 0)
+        {
+            processes[next_process].completion_time = current_time;
+
+            completed_processes++;   // Increment the number of completed processes
+            running = -1;
+            PREEMPTIVE_ENGINE_COMPLETION(current_time);
+        }
+
+        // Update the Gantt chart
+        add_gantt_slot(processes[next_process].process_id, current_time);
+    }
+
+    PREEMPTIVE_ENGINE_TIMER_STOP(schedule_time);
+
+    finish_checkpoints();   // The run is complete, so its checkpoint is no longer needed
+}
+
+#undef PREEMPTIVE_ENGINE_NAME
+#undef PREEMPTIVE_ENGINE_KEY
+#undef PREEMPTIVE_ENGINE_BEFORE
+#undef PREEMPTIVE_ENGINE_PREEMPTS
+#undef PREEMPTIVE_ENGINE_COUNT
+#undef PREEMPTIVE_ENGINE_TIMER_START
+#undef PREEMPTIVE_ENGINE_TIMER_STOP
+#undef PREEMPTIVE_ENGINE_BUSY
+#undef PREEMPTIVE_ENGINE_COMPLETION
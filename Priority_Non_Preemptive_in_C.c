@@ -1,6 +1,16 @@
+#define _DEFAULT_SOURCE  // clock_gettime, futimens and kill are POSIX, declare them under -std=c11 as well
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #define MAX_PROCESS 10  // Maximum number of processes
+#define ENABLE_STATS 1  // Set to 0 to compile the hot-path counters and timers out of the engine
+#define RESULT_COLUMNS 7  // Number of columns in the resultant table
+#define CACHE_TAG "PNP"  // Name of the policy in the cache key, so programs sharing a cache directory never mix results
+#define PROCESS_HAS_PRIORITY  // The workload reader and the cache key include the priority of every process
+#define BUSY_PERIODS_ENGINE() non_preemptive_priority_scheduling()  // Engine run by --busy-periods on every busy period
+#define BUSY_PERIODS_GANTT_INDICES  // The Gantt chart holds indices into the process array
 
 // Structure to represent a process
 typedef struct
@@ -9,18 +19,84 @@ typedef struct
     int arrival_time;       // Arrival time of the process
     int burst_time;         // Burst time (time required for execution)
     int completion_time;    // Time at which the process finishes execution
-    int turn_around_time;   // Turnaround time = Completion time - Arrival time
-    int waiting_time;       // Waiting time = Turnaround time - Burst time
     int priority;           // Priority of the process
     int remaining_time;     // Remaining time for the process during execution
 } Process;   
 
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
 Process processes[MAX_PROCESS];    // Declare an array of processes with a maximum size of 10
 
 int gantt_chart[MAX_PROCESS], I = 0;   // Array to store the order of processes in the Gantt chart and a counter variable
 
 int n;  // Global variable to store the number of processes
 
+// Structure to hold the hot-path counters and phase timers reported by --stats
+typedef struct
+{
+    long long events;       // Iterations of the scheduling loop
+    long long dispatches;   // Times a process was picked to run
+    long long scanned;      // Candidates examined while picking a process
+    long long idle_jumps;   // Jumps of the clock over an idle gap
+    long long sort_swaps;   // Swaps made while sorting by arrival time
+    double sort_time;       // Seconds spent sorting by arrival time
+    double schedule_time;   // Seconds spent in the scheduling loop
+    double output_time;     // Seconds spent printing and writing the results
+} Stats;
+
+Stats stats;    // Counters and timers of the current run
+
+// Function to read the monotonic clock in seconds
+double monotonic_seconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// The counters and timers compile to nothing when ENABLE_STATS is 0
+#if ENABLE_STATS
+#define STAT_ADD(counter, amount) (stats.counter += (amount))
+#define STAT_TIMER_START(timer) double timer##_started = monotonic_seconds()
+#define STAT_TIMER_STOP(timer) (stats.timer += monotonic_seconds() - timer##_started)
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#define STAT_TIMER_START(timer) ((void)0)
+#define STAT_TIMER_STOP(timer) ((void)0)
+#endif
+
+// Function to print the profile of the run collected by the counters and timers
+void print_stats()
+{
+    printf("\nStatistics:\n");
+#if ENABLE_STATS
+    printf("Events processed:     %lld\n", stats.events);
+    printf("Dispatches:           %lld\n", stats.dispatches);
+    printf("Candidates scanned:   %lld\n", stats.scanned);
+    printf("Idle jumps:           %lld\n", stats.idle_jumps);
+    printf("Sort swaps:           %lld\n", stats.sort_swaps);
+    printf("Sort time:            %.6f s\n", stats.sort_time);
+    printf("Scheduling time:      %.6f s\n", stats.schedule_time);
+    printf("Output time:          %.6f s\n", stats.output_time);
+#else
+    printf("Statistics were compiled out, rebuild with ENABLE_STATS set to 1.\n");
+#endif
+}
+
+// Windowed telemetry of the run, recorded by the engine through telemetry_busy and telemetry_completion
+#include "Telemetry.h"
+
 // Function to perform Non Pre-emptive Priority Scheduling and calculate completion time, turnaround time and waiting time for each process
 void non_preemptive_priority_scheduling()
 {
@@ -33,8 +109,11 @@ void non_preemptive_priority_scheduling()
     }
 
     // Execute the processes using a scheduling algorithm (Non Pre-emptive Priority Scheduling)
+    STAT_TIMER_START(schedule_time);
+
     while (completed_processes < n) 
     {
+        STAT_ADD(events, 1);
         min_priority = __INT_MAX__;     // Initialize with maximum integer value
         shortest_process = -1;          // Initialize to an invalid index
 
@@ -47,29 +126,43 @@ void non_preemptive_priority_scheduling()
                 shortest_process = i;
             }
         }
+        STAT_ADD(scanned, n);
 
-        // If no process is ready to execute, increment the current time
+        // If no process is ready to execute, the CPU is idle until the next arrival, so jump straight to it
         if (shortest_process == -1) 
         {
-            current_time++;
+            int next_arrival = __INT_MAX__;
+
+            for (int i = 0; i < n; i++)
+            {
+                if (processes[i].remaining_time > 0 && processes[i].arrival_time < next_arrival)
+                    next_arrival = processes[i].arrival_time;
+            }
+
+            current_time = next_arrival;
+            STAT_ADD(idle_jumps, 1);
             continue;
         }
 
+        STAT_ADD(dispatches, 1);
+
         // Update the process details after executing the selected process
         current_time += processes[shortest_process].burst_time;
         processes[shortest_process].completion_time = current_time;
         processes[shortest_process].remaining_time = 0;
 
-        // Calculate turnaround time and waiting time
-        processes[shortest_process].turn_around_time = processes[shortest_process].completion_time - processes[shortest_process].arrival_time;
-        processes[shortest_process].waiting_time = processes[shortest_process].turn_around_time - processes[shortest_process].burst_time;
-
         completed_processes++;  // Increment the count of completed processes
 
+        // Record the execution in the telemetry windows
+        telemetry_busy(current_time - processes[shortest_process].burst_time, current_time);
+        telemetry_completion(current_time);
+
         // Store the process ID in the Gantt chart order array
         gantt_chart[I] = shortest_process;
         I++;
     }
+
+    STAT_TIMER_STOP(schedule_time);
 }
 
 // Function to calculate average turnaround time
@@ -79,7 +172,7 @@ float calculate_average_turnaround_time()
 
     // Calculate the sum of all turnaround times
     for (int i = 0; i < n; i++)
-        total_turnaround_time += processes[i].turn_around_time;
+        total_turnaround_time += turn_around_time(&processes[i]);
 
     return (float)total_turnaround_time / n;    // Return the average turnaround time
 }
@@ -91,7 +184,7 @@ float calculate_average_waiting_time()
 
     // Calculate the sum of all waiting times
     for (int i = 0; i < n; i++)
-        total_waiting_time += processes[i].waiting_time;
+        total_waiting_time += waiting_time(&processes[i]);
 
     return (float)total_waiting_time / n;   // Return the average waiting time
 }
@@ -113,8 +206,8 @@ void print_resultant_table()
             processes[i].arrival_time, 
             processes[i].burst_time, 
             processes[i].completion_time, 
-            processes[i].turn_around_time, 
-            processes[i].waiting_time,
+            turn_around_time(&processes[i]), 
+            waiting_time(&processes[i]),
             processes[i].priority
         );
 
@@ -178,26 +271,219 @@ void print_gantt_chart()
 }
 
 
+#include "Gantt_Renderer.h"     // Streaming SVG renderer used by write_gantt_chart
+
+// Function to write the Gantt chart to a file as an SVG drawing, or as an HTML page when html is set
+// Returns 0 on success and -1 if the file cannot be opened or written
+int write_gantt_chart(const char *path, int html)
+{
+    FILE *file = fopen(path, "w");
+    Gantt_Renderer renderer;
+
+    if (file == NULL)
+        return -1;
+
+    int end_time = (I > 0) ? processes[gantt_chart[I - 1]].completion_time : 1;
+
+    begin_gantt_drawing(&renderer, file, end_time, html);
+
+    for (int i = 0; i < I; i++)
+        render_gantt_segment(&renderer, processes[gantt_chart[i]].process_id, processes[gantt_chart[i]].completion_time - processes[gantt_chart[i]].burst_time, processes[gantt_chart[i]].completion_time);
+
+    return end_gantt_drawing(&renderer, end_time, html);
+}
+
+// Column names of the resultant table, in the order they are written
+const char *result_columns[RESULT_COLUMNS] = {
+    "process_id",
+    "arrival_time",
+    "burst_time",
+    "completion_time",
+    "turn_around_time",
+    "waiting_time",
+    "priority"
+};
+
+// Function to fill the columns of row i of the resultant table
+void result_row(int i, int values[])
+{
+    values[0] = processes[i].process_id;
+    values[1] = processes[i].arrival_time;
+    values[2] = processes[i].burst_time;
+    values[3] = processes[i].completion_time;
+    values[4] = turn_around_time(&processes[i]);
+    values[5] = waiting_time(&processes[i]);
+    values[6] = processes[i].priority;
+}
+
+#include "Result_Writer.h"      // write_results, writing the rows filled by result_row
+#include "Workload_Reader.h"    // load_workload, reading the files written by Trace_Import_in_C.c
+#include "Result_Cache.h"       // cache_lookup and cache_store, keyed by workload_key
+#include "Busy_Periods.h"       // run_busy_periods, simulating the busy periods in worker processes
+
 // Main function: Entry point of the program
-int main()
+int main(int argc, char *argv[])
 {
-    // Input the number of processes
-    printf("Enter the number of processes: ");
-    scanf("%d", &n);
+    const char *output_path = NULL;     // File for the machine-readable results, if requested
+    int output_format = FORMAT_CSV;     // Format of the machine-readable results
+    const char *gantt_path = NULL;      // File for the drawn Gantt chart, if requested
+    int gantt_html = 0;                 // Set when the Gantt chart is drawn as an HTML page
+    int show_stats = 0;                 // Set by --stats
+    const char *telemetry_path = NULL;  // File for the windowed telemetry, if requested
+    int window_width = 10;              // Width of a telemetry window in units of time
+    const char *workload_path = NULL;   // Binary workload to read instead of the interactive input, if requested
+    const char *cache_dir = NULL;       // Directory of cached results, if requested
+    int busy_workers = 0;               // Worker processes of --busy-periods, 0 to run the engine once over the whole workload
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stats") == 0)
+        {
+            show_stats = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--cache") == 0)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--busy-periods") == 0)
+        {
+            busy_workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--telemetry") == 0)
+        {
+            telemetry_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--window") == 0)
+        {
+            window_width = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--csv") == 0)
+        {
+            output_format = FORMAT_CSV;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--jsonl") == 0)
+        {
+            output_format = FORMAT_JSONL;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--binary") == 0)
+        {
+            output_format = FORMAT_BINARY;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && (strcmp(argv[i], "--svg") == 0 || strcmp(argv[i], "--html") == 0))
+        {
+            gantt_html = (strcmp(argv[i], "--html") == 0);
+            gantt_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
 
-    // Input the arrival and burst times for each process
-    for (int i = 0; i < n; i++)
+    if (window_width <= 0)
+    {
+        printf("Telemetry window width must be positive.\n");
+        return 1;
+    }
+
+    if (busy_workers < 0 || busy_workers > MAX_BUSY_WORKERS)
+    {
+        printf("Number of busy period workers must be between 1 and %d.\n", MAX_BUSY_WORKERS);
+        return 1;
+    }
+
+    // The engine records the telemetry and the counters in the workers, where they would be lost
+    if (busy_workers > 0 && (telemetry_path != NULL || show_stats))
+    {
+        printf("--busy-periods cannot be combined with --telemetry, --stats.\n");
+        return 1;
+    }
+
+    // The engine itself feeds the telemetry, so runs with telemetry are not cached
+    if (telemetry_path != NULL)
+        cache_dir = NULL;
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of 1 to %d processes from %s.\n", MAX_PROCESS, workload_path);
+            return 1;
+        }
+    }
+    else
+    {
+        // Input the number of processes
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Input the arrival and burst times for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d : ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d : ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+            printf("Enter the priorities of P%d (0 being the highest) : ", i + 1);
+            scanf("%d", &processes[i].priority);
+        }
+    }
+
+    // Start the windowed telemetry if requested, the engine feeds it while it runs
+    if (telemetry_path != NULL && begin_telemetry(telemetry_path, window_width) == -1)
     {
-        processes[i].process_id = i + 1;
-        printf("Enter the arrival time of P%d : ", i + 1);
-        scanf("%d", &processes[i].arrival_time);
-        printf("Enter the burst time of P%d : ", i + 1);
-        scanf("%d", &processes[i].burst_time);
-        printf("Enter the priorities of P%d (0 being the highest) : ", i + 1);
-        scanf("%d", &processes[i].priority);
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
     }
 
-    non_preemptive_priority_scheduling();   // Perform the Non Pre-emptive Priority Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+    unsigned long long cache_key = (cache_dir != NULL) ? workload_key() : 0;   // Key of the cached result, taken before the engine reorders the processes
+
+    // Reuse the cached result of the same workload and parameters if there is one, otherwise run the engine and cache its result
+    if (cache_dir != NULL && cache_lookup(cache_dir, cache_key) == 0)
+    {
+        printf("\nResult loaded from the cache.\n");
+    }
+    else
+    {
+        // With --busy-periods, simulate the busy periods in worker processes instead of running the engine once
+        if (busy_workers > 0)
+        {
+            int periods = run_busy_periods(busy_workers);
+
+            if (periods == -1)
+            {
+                printf("Could not simulate the busy periods in worker processes.\n");
+                return 1;
+            }
+            printf("\nSimulated %d busy periods on %d worker processes.\n", periods, (busy_workers < periods) ? busy_workers : periods);
+        }
+        else
+        {
+            non_preemptive_priority_scheduling();   // Perform the Non Pre-emptive Priority Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+        }
+
+        if (cache_dir != NULL && cache_store(cache_dir, cache_key) == -1)
+            printf("Could not write the result to the cache in %s.\n", cache_dir);
+    }
+
+    if (end_telemetry() == -1)
+    {
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
+    }
+
+    STAT_TIMER_START(output_time);
 
     print_gantt_chart();        // Print the Gantt chart
     
@@ -207,5 +493,25 @@ int main()
     printf("\nAverage Turnaround Time: %f\n", calculate_average_turnaround_time());
     printf("Average Waiting Time: %f\n", calculate_average_waiting_time());
 
+    // Write the results in the requested machine-readable format
+    if (output_path != NULL && write_results(output_path, output_format) == -1)
+    {
+        printf("Could not write the results to %s.\n", output_path);
+        return 1;
+    }
+
+    // Draw the Gantt chart to a file if requested
+    if (gantt_path != NULL && write_gantt_chart(gantt_path, gantt_html) == -1)
+    {
+        printf("Could not write the Gantt chart to %s.\n", gantt_path);
+        return 1;
+    }
+
+    STAT_TIMER_STOP(output_time);
+
+    // Print where the run spent its time if requested
+    if (show_stats)
+        print_stats();
+
     return 0;   // Return 0 to indicate successful execution
 }
@@ -0,0 +1,28 @@
+// Quantum step of round_robin_scheduling shared by Round_Robin_in_C.c, Lottery_in_C.c and Stride_in_C.c
+//
+// Before including this header, the including file defines the Process structure with remaining_time and
+// completion_time fields. The policies only differ in which process they hand the next quantum to, so each engine
+// picks the process and calls run_quantum to run it.
+
+#ifndef QUANTUM_STEP_H
+#define QUANTUM_STEP_H
+
+// Function to run a process for one quantum of q units from *current_time, or less if it finishes earlier
+// Advances the clock, and records the completion time once the process is done
+// Returns 1 if the process finished during this quantum, 0 if it still has remaining time
+static inline int run_quantum(Process *process, int *current_time, int q)
+{
+    if (process->remaining_time > q)
+    {
+        *current_time += q;
+        process->remaining_time -= q;
+        return 0;
+    }
+
+    *current_time += process->remaining_time;
+    process->remaining_time = 0;
+    process->completion_time = *current_time;
+    return 1;
+}
+
+#endif
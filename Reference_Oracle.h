@@ -0,0 +1,256 @@
+// Reference scheduling engines used as an oracle for the fast engines
+//
+// These are the scan loops of FCFS_in_C.c, SJF_in_C.c, Priority_Non_Preemptive_in_C.c, Round_Robin_in_C.c and
+// Preemptive_Engine.h, kept with their O(n²) behaviour but taken out of the global process arrays: every function
+// reads the jobs from plain arrays, sorted by arrival time, and writes the completion time of job i to completion[i].
+// They are the definition of what the programs compute, so a faster engine is correct when it produces the same
+// completion times on the same input. Turnaround and waiting times follow from the completion times, so only those
+// are compared. Being copies, they are themselves checked against the compiled programs by
+// Online_Scheduler_in_C.c --verify N --engines DIR.
+
+#ifndef REFERENCE_ORACLE_H
+#define REFERENCE_ORACLE_H
+
+#include <stdlib.h>
+
+// Function to schedule the jobs First Come First Served
+static void reference_fcfs(int n, const int *arrival, const int *burst, int *completion)
+{
+    int current_time = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        // If the job has not arrived yet, the CPU is idle until it does
+        if (current_time < arrival[i])
+            current_time = arrival[i];
+
+        current_time += burst[i];
+        completion[i] = current_time;
+    }
+}
+
+// Function to schedule the jobs non-preemptively, always running the arrived job with the smallest key to completion:
+// its priority, or its burst time (SJF) when priority is NULL. Ties go to the earliest arrival
+static void reference_non_preemptive(int n, const int *arrival, const int *burst, const int *priority, int *completion)
+{
+    int current_time = 0, completed_processes = 0;
+
+    for (int i = 0; i < n; i++)
+        completion[i] = -1;
+
+    while (completed_processes < n)
+    {
+        int min_key = __INT_MAX__, next_process = -1;
+
+        // Find the unfinished job with the smallest key which has arrived
+        for (int i = 0; i < n; i++)
+        {
+            int key = (priority == NULL) ? burst[i] : priority[i];
+
+            if (arrival[i] <= current_time && completion[i] == -1 && key < min_key)
+            {
+                min_key = key;
+                next_process = i;
+            }
+        }
+
+        // If no job is ready, the CPU is idle until the next arrival, which is the first unfinished job
+        if (next_process == -1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (completion[i] == -1)
+                {
+                    current_time = arrival[i];
+                    break;
+                }
+            }
+
+            continue;
+        }
+
+        current_time += burst[next_process];
+        completion[next_process] = current_time;
+        completed_processes++;
+    }
+}
+
+// Function to schedule the jobs pre-emptively one unit of time at a time, always running the arrived job with the
+// smallest key: its priority, or its remaining time (SRTF) when priority is NULL. Ties go to the earliest arrival
+// Returns -1 if the remaining times could not be allocated
+static int reference_preemptive(int n, const int *arrival, const int *burst, const int *priority, int *completion)
+{
+    int current_time = 0, completed_processes = 0;
+    int *remaining = malloc(n * sizeof(int));
+
+    if (remaining == NULL)
+        return -1;
+
+    for (int i = 0; i < n; i++)
+        remaining[i] = burst[i];
+
+    while (completed_processes < n)
+    {
+        int min_key = __INT_MAX__, next_process = -1;
+
+        // Find the arrived job with the smallest key, a strictly smaller key is needed to replace an earlier arrival
+        for (int i = 0; i < n; i++)
+        {
+            int key = (priority == NULL) ? remaining[i] : priority[i];
+
+            if (arrival[i] <= current_time && remaining[i] > 0 && key < min_key)
+            {
+                min_key = key;
+                next_process = i;
+            }
+        }
+
+        // If no job is ready, the CPU is idle until the next arrival, which is the first unfinished job
+        if (next_process == -1)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (remaining[i] > 0)
+                {
+                    current_time = arrival[i];
+                    break;
+                }
+            }
+
+            continue;
+        }
+
+        remaining[next_process]--;
+        current_time++;
+
+        if (remaining[next_process] == 0)
+        {
+            completion[next_process] = current_time;
+            completed_processes++;
+        }
+    }
+
+    free(remaining);
+    return 0;
+}
+
+// Function to schedule the jobs Round Robin the way Round_Robin_in_C.c does: every pass sweeps the jobs in arrival
+// order and gives each arrived unfinished job one quantum, so a job that arrives during a pass still runs in it
+// Returns -1 if the remaining times could not be allocated
+static int reference_round_robin(int n, const int *arrival, const int *burst, int quantum, int *completion)
+{
+    int current_time = 0, completed_processes = 0;
+    int *remaining = malloc(n * sizeof(int));
+
+    if (remaining == NULL)
+        return -1;
+
+    for (int i = 0; i < n; i++)
+        remaining[i] = burst[i];
+
+    while (completed_processes < n)
+    {
+        int executed = 0;
+
+        for (int i = 0; i < n; i++)
+        {
+            if (arrival[i] <= current_time && remaining[i] > 0)
+            {
+                int slice = (remaining[i] < quantum) ? remaining[i] : quantum;
+
+                current_time += slice;
+                remaining[i] -= slice;
+                executed = 1;
+
+                if (remaining[i] == 0)
+                {
+                    completion[i] = current_time;
+                    completed_processes++;
+                }
+            }
+        }
+
+        // If no job was ready, the CPU is idle until the next arrival, which is the first unfinished job
+        if (!executed)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (remaining[i] > 0)
+                {
+                    current_time = arrival[i];
+                    break;
+                }
+            }
+        }
+    }
+
+    free(remaining);
+    return 0;
+}
+
+// Function to schedule the jobs Round Robin from a FIFO one unit of time at a time: a job whose quantum ends goes
+// to the back, behind the jobs that arrived up to that moment
+// Returns -1 if the queue and the remaining times could not be allocated
+static int reference_round_robin_fifo(int n, const int *arrival, const int *burst, int quantum, int *completion)
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+    int running = -1, slice_used = 0, head = 0, count = 0;
+    int *remaining = malloc(n * sizeof(int)), *queue = malloc(n * sizeof(int));
+
+    if (remaining == NULL || queue == NULL)
+    {
+        free(remaining);
+        free(queue);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++)
+        remaining[i] = burst[i];
+
+    while (completed_processes < n)
+    {
+        // Queue every job that has arrived by now, ahead of a job whose quantum ends now
+        while (next_arrival < n && arrival[next_arrival] <= current_time)
+        {
+            queue[(head + count++) % n] = next_arrival++;
+        }
+
+        if (running != -1 && slice_used == quantum)
+        {
+            queue[(head + count++) % n] = running;
+            running = -1;
+        }
+
+        if (running == -1)
+        {
+            // If no job is ready, the CPU is idle until the next arrival
+            if (count == 0)
+            {
+                current_time = arrival[next_arrival];
+                continue;
+            }
+
+            running = queue[head];
+            head = (head + 1) % n;
+            count--;
+            slice_used = 0;
+        }
+
+        remaining[running]--;
+        slice_used++;
+        current_time++;
+
+        if (remaining[running] == 0)
+        {
+            completion[running] = current_time;
+            completed_processes++;
+            running = -1;
+        }
+    }
+
+    free(remaining);
+    free(queue);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,211 @@
+// Content-addressed cache of scheduling results shared by the scheduling programs
+//
+// Before including this header, define CACHE_TAG, the name of the policy in the cache key, and provide the process
+// array processes, the process count n, and the Gantt chart array gantt_chart with its entry count I.
+// Optional definitions:
+//   PROCESS_HAS_PRIORITY       the priority of every process is part of the workload and hashed into the key
+//   CACHE_KEY_PARAMETERS(key)  statement hashing the policy parameters into key, such as the quantum
+//   CACHE_NO_GANTT             the program has no Gantt chart array, only the processes are cached
+// A result is a plain image of the engine arrays behind a header, so it is mapped and copied back without any parsing.
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CACHE_MAGIC 0x52534543u  // First word of a cached result file
+#define MAX_CACHE_ENTRIES 256  // Number of cached results kept before the least recently used ones are evicted
+
+// Structure of the header of a cached result, followed by the process array and the Gantt chart
+typedef struct
+{
+    unsigned int magic;         // CACHE_MAGIC
+    unsigned int record_size;   // sizeof(Process), so a result written by a different build is never misread
+    unsigned long long key;     // Hash of the workload and the policy parameters
+    int n;                      // Number of processes
+#ifndef CACHE_NO_GANTT
+    int I;                      // Number of Gantt chart entries
+#endif
+} Cache_Header;
+
+// Function to add bytes to a 64-bit FNV-1a hash
+static unsigned long long hash_bytes(unsigned long long hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = data;
+
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+
+    return hash;
+}
+
+// Function to hash the policy, its parameters and the workload of every process into the cache key
+// It must be called before the engine runs, since the engine reorders the processes
+static unsigned long long workload_key()
+{
+    unsigned long long key = hash_bytes(0xCBF29CE484222325ULL, CACHE_TAG, sizeof(CACHE_TAG));
+
+#ifdef CACHE_KEY_PARAMETERS
+    CACHE_KEY_PARAMETERS(key);
+#endif
+    key = hash_bytes(key, &n, sizeof(n));
+    for (int i = 0; i < n; i++)
+    {
+        key = hash_bytes(key, &processes[i].arrival_time, sizeof(int));
+        key = hash_bytes(key, &processes[i].burst_time, sizeof(int));
+#ifdef PROCESS_HAS_PRIORITY
+        key = hash_bytes(key, &processes[i].priority, sizeof(int));
+#endif
+    }
+
+    return key;
+}
+
+// Function to build the file name of a cached result
+static void cache_path(char *path, size_t size, const char *dir, unsigned long long key)
+{
+    snprintf(path, size, "%s/%016llx.result", dir, key);
+}
+
+// Function to load a cached result into the engine arrays, returns 0 on a hit and -1 on a miss
+static int cache_lookup(const char *dir, unsigned long long key)
+{
+    char path[4096];
+    struct stat info;
+
+    cache_path(path, sizeof(path), dir, key);
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return -1;
+
+    if (fstat(fd, &info) == -1 || info.st_size < (off_t)sizeof(Cache_Header))
+    {
+        close(fd);
+        return -1;
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const Cache_Header *header = data;
+
+    // Accept the entry only if it belongs to this key and has exactly the expected size
+#ifdef CACHE_NO_GANTT
+    size_t expected_size = sizeof(Cache_Header) + (size_t)n * sizeof(Process);
+#else
+    size_t expected_size = (data == MAP_FAILED) ? 0
+        : sizeof(Cache_Header) + (size_t)n * sizeof(Process) + (size_t)header->I * sizeof(gantt_chart[0]);
+#endif
+
+    if (data == MAP_FAILED || header->magic != CACHE_MAGIC || header->record_size != sizeof(Process) || header->key != key
+        || header->n != n
+#ifndef CACHE_NO_GANTT
+        || header->I < 0 || header->I > (int)(sizeof(gantt_chart) / sizeof(gantt_chart[0]))
+#endif
+        || (size_t)info.st_size != expected_size)
+    {
+        if (data != MAP_FAILED)
+            munmap(data, (size_t)info.st_size);
+        close(fd);
+        return -1;
+    }
+
+    memcpy(processes, (const char *)data + sizeof(Cache_Header), (size_t)n * sizeof(Process));
+#ifndef CACHE_NO_GANTT
+    memcpy(gantt_chart, (const char *)data + sizeof(Cache_Header) + (size_t)n * sizeof(Process), (size_t)header->I * sizeof(gantt_chart[0]));
+    I = header->I;
+#endif
+
+    munmap(data, (size_t)info.st_size);
+    futimens(fd, NULL);     // Mark the entry as recently used for the eviction
+    close(fd);
+    return 0;
+}
+
+// Function to evict the least recently used result if the cache holds more than MAX_CACHE_ENTRIES results
+static void cache_evict(const char *dir)
+{
+    DIR *directory = opendir(dir);
+    struct dirent *entry;
+    struct stat info;
+    char path[4096], oldest[4096] = "";
+    struct timespec oldest_time = { 0, 0 };
+    int entries = 0;
+
+    if (directory == NULL)
+        return;
+
+    // Count the results and find the one used longest ago
+    while ((entry = readdir(directory)) != NULL)
+    {
+        size_t length = strlen(entry->d_name);
+
+        if (length < 7 || strcmp(entry->d_name + length - 7, ".result") != 0)
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+        if (stat(path, &info) == -1)
+            continue;
+
+        entries++;
+        if (oldest[0] == '\0' || info.st_mtim.tv_sec < oldest_time.tv_sec
+            || (info.st_mtim.tv_sec == oldest_time.tv_sec && info.st_mtim.tv_nsec < oldest_time.tv_nsec))
+        {
+            strcpy(oldest, path);
+            oldest_time = info.st_mtim;
+        }
+    }
+
+    closedir(directory);
+
+    if (entries > MAX_CACHE_ENTRIES)
+        unlink(oldest);
+}
+
+// Function to store the result of the engine in the cache, returns -1 on error
+// The entry is written to a temporary file and renamed, so a reader never maps a partial result
+static int cache_store(const char *dir, unsigned long long key)
+{
+    char path[4096], temporary[4200];
+#ifdef CACHE_NO_GANTT
+    Cache_Header header = { CACHE_MAGIC, sizeof(Process), key, n };
+#else
+    Cache_Header header = { CACHE_MAGIC, sizeof(Process), key, n, I };
+#endif
+
+    cache_path(path, sizeof(path), dir, key);
+    snprintf(temporary, sizeof(temporary), "%s.%d.tmp", path, (int)getpid());
+
+    int fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        return -1;
+
+    if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)
+        || write(fd, processes, (size_t)n * sizeof(Process)) != (ssize_t)((size_t)n * sizeof(Process))
+#ifndef CACHE_NO_GANTT
+        || write(fd, gantt_chart, (size_t)I * sizeof(gantt_chart[0])) != (ssize_t)((size_t)I * sizeof(gantt_chart[0]))
+#endif
+        )
+    {
+        close(fd);
+        unlink(temporary);
+        return -1;
+    }
+
+    if (close(fd) == -1 || rename(temporary, path) == -1)
+    {
+        unlink(temporary);
+        return -1;
+    }
+
+    cache_evict(dir);
+    return 0;
+}
+
+#endif
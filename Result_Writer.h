@@ -0,0 +1,144 @@
+// Buffered result writer shared by the scheduling programs
+//
+// Before including this header, define RESULT_COLUMNS and declare:
+//   const char *result_columns[RESULT_COLUMNS]    names of the columns, in the order they are written
+//   void result_row(int i, int values[])           fills the columns of row i of the resultant table
+// write_results writes the rows 0 to n - 1, so the includer also provides the global n.
+// Every value is formatted by hand into one reusable buffer, and the buffer goes to the file in as few write calls
+// as possible, repeating a call that was cut short until everything is written.
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#define OUTPUT_BUFFER_SIZE 65536  // Size of the reusable buffer of the result writer
+
+// Output formats supported by the result writer
+enum { FORMAT_CSV, FORMAT_JSONL, FORMAT_BINARY };
+
+static char output_buffer[OUTPUT_BUFFER_SIZE];  // Reusable buffer of the result writer
+static int output_length = 0;                   // Number of bytes waiting in the buffer
+static int output_failed = 0;                   // Set when a write failed, reported once the file is closed
+
+// Function to write the buffered bytes to the file, calling write again after a short write until all are written
+static void flush_output(int fd)
+{
+    int written = 0;
+
+    while (written < output_length && !output_failed)
+    {
+        ssize_t result = write(fd, output_buffer + written, output_length - written);
+
+        if (result == -1 && errno == EINTR)
+            continue;   // Interrupted before anything was written, try again
+
+        if (result <= 0)
+            output_failed = 1;
+        else
+            written += (int)result;
+    }
+
+    output_length = 0;
+}
+
+// Function to append bytes to the output buffer, flushing it first if they do not fit
+static void append_output(int fd, const char *data, int length)
+{
+    if (output_length + length > OUTPUT_BUFFER_SIZE)
+        flush_output(fd);
+
+    memcpy(output_buffer + output_length, data, length);
+    output_length += length;
+}
+
+// Function to append an integer in decimal, formatted by hand instead of through printf
+static void append_int(int fd, int value)
+{
+    char digits[11];
+    int length = 0;
+    unsigned int magnitude = (value < 0) ? -(unsigned int)value : (unsigned int)value;
+
+    // Fill the digits from the right
+    do
+    {
+        digits[10 - length++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (value < 0)
+        digits[10 - length++] = '-';
+
+    append_output(fd, digits + 11 - length, length);
+}
+
+// Function to write the resultant table to a file as CSV, JSON Lines or fixed-width binary records (native 32-bit integers)
+// Returns 0 on success and -1 if the file cannot be opened or a write fails
+static int write_results(const char *path, int format)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd == -1)
+        return -1;
+
+    output_length = 0;
+    output_failed = 0;
+
+    // The CSV header row lists the column names
+    if (format == FORMAT_CSV)
+    {
+        for (int j = 0; j < RESULT_COLUMNS; j++)
+        {
+            if (j > 0)
+                append_output(fd, ",", 1);
+            append_output(fd, result_columns[j], strlen(result_columns[j]));
+        }
+        append_output(fd, "\n", 1);
+    }
+
+    for (int i = 0; i < n && !output_failed; i++)
+    {
+        int values[RESULT_COLUMNS];
+
+        result_row(i, values);
+
+        if (format == FORMAT_BINARY)
+        {
+            append_output(fd, (const char *)values, sizeof(values));
+            continue;
+        }
+
+        append_output(fd, "{", format == FORMAT_JSONL);
+
+        for (int j = 0; j < RESULT_COLUMNS; j++)
+        {
+            if (j > 0)
+                append_output(fd, ",", 1);
+
+            // JSON Lines records name every value
+            if (format == FORMAT_JSONL)
+            {
+                append_output(fd, "\"", 1);
+                append_output(fd, result_columns[j], strlen(result_columns[j]));
+                append_output(fd, "\":", 2);
+            }
+
+            append_int(fd, values[j]);
+        }
+
+        append_output(fd, "}", format == FORMAT_JSONL);
+        append_output(fd, "\n", 1);
+    }
+
+    flush_output(fd);
+
+    if (close(fd) == -1)
+        output_failed = 1;
+
+    return output_failed ? -1 : 0;
+}
+
+#endif
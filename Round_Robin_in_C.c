@@ -1,6 +1,23 @@
+#define _DEFAULT_SOURCE  // clock_gettime, futimens and kill are POSIX, declare them under -std=c11 as well
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <math.h>
+#include <sys/wait.h>
 
 #define MAX_PROCESS 10  // Maximum number of processes that can be handled
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+#define ENABLE_STATS 1  // Set to 0 to compile the hot-path counters and timers out of the engine
+#define RESULT_COLUMNS 7  // Number of columns in the resultant table
+#define CACHE_TAG "RR"  // Name of the policy in the cache key, so programs sharing a cache directory never mix results
+#define CACHE_KEY_PARAMETERS(key) (key = hash_bytes(key, &q, sizeof(q)))  // The quantum is part of the cache key
+#define BUSY_PERIODS_ENGINE() round_robin_scheduling()  // Engine run by --busy-periods on every busy period
+#define BUSY_PERIODS_SORTED  // round_robin_scheduling sorts the processes by arrival time
+#define MONTE_CARLO_METRICS 3  // Metrics collected per replica: average turnaround, waiting and response time
+#define CHECKPOINT_FILE "round_robin_checkpoint.bin"  // File holding the latest checkpoint of the engine state
+#define CHECKPOINT_INTERVAL 1000  // Number of scheduling steps between two checks of the checkpoint clock
 
 // Structure to represent Process
 typedef struct
@@ -9,11 +26,28 @@ typedef struct
     int arrival_time;      // Time at which the process arrives in the ready queue
     int burst_time;        // CPU burst time required by the process
     int completion_time;   // Time at which the process finishes execution
-    int turn_around_time;  // Turnaround time (completion_time - arrival_time)
-    int waiting_time;      // Waiting time (turn_around_time - burst_time)
+    int first_run_time;    // Time at which the process is dispatched for the first time
     int remaining_time;    // Remaining time for the process to execute
 } Process;
 
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Function to derive the response time of a process from its first dispatch
+static inline int response_time(const Process *p)
+{
+    return p->first_run_time - p->arrival_time;
+}
+
 // Structure to represent Gantt chart
 typedef struct
 {
@@ -21,41 +55,229 @@ typedef struct
     int time;
 }G;
 
-G gantt_chart[2 * MAX_PROCESS]; // Array of Gantt chart
+// Structure to represent the header of a checkpoint file, followed by the process array and the Gantt chart
+typedef struct
+{
+    char magic[4];              // "RRQS" - identifies the engine that wrote the checkpoint
+    int n;                      // Number of processes
+    int q;                      // Time quantum of the run
+    int current_time;           // Clock of the engine when the checkpoint was taken
+    int completed_processes;    // Number of processes completed so far
+    int I;                      // Number of Gantt chart slots written so far
+} Checkpoint_Header;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
 Process processes[MAX_PROCESS]; // Array of processes
 int I = 0;  // Gantt chart tracker index
+int gantt_truncated = 0;  // Set once a slot is dropped from the full Gantt chart
 int n, q;  // Number of processes and time quantum (slice of time for Round Robin)
+int resumed = 0;  // Set when the run continues from a checkpoint
+int recording_gantt = 1;  // Cleared when the engine runs many throwaway workloads whose Gantt chart is never shown
+int workload_sorted = 0;  // Set once the processes are in arrival order, so further runs on the same workload skip the sort
+int checkpoint_time = 0, checkpoint_completed_processes = 0;  // Engine clock and progress restored from the checkpoint
+
+#define CHECKPOINT_SNAPSHOT_SIZE (sizeof(Checkpoint_Header) + MAX_PROCESS * sizeof(Process) + MAX_SLOTS * sizeof(G))
+#include "Checkpoint_Writer.h"  // begin_checkpoint and commit_checkpoint, writing checkpoints on a background thread
+#include "Quantum_Step.h"       // run_quantum, running a process for one quantum
+
+// Function to copy the engine state into a checkpoint snapshot, once every checkpoint_period seconds
+// The engine only pays for the copy, the snapshot is written to the checkpoint file by the writer thread
+void save_checkpoint(int current_time, int completed_processes)
+{
+    Checkpoint_Header header;
+    unsigned char *snapshot = begin_checkpoint();
+
+    if (snapshot == NULL)
+        return;
+
+    memcpy(header.magic, "RRQS", 4);
+    header.n = n;
+    header.q = q;
+    header.current_time = current_time;
+    header.completed_processes = completed_processes;
+    header.I = I;
+
+    memcpy(snapshot, &header, sizeof(header));
+    memcpy(snapshot + sizeof(header), processes, n * sizeof(Process));
+    memcpy(snapshot + sizeof(header) + n * sizeof(Process), gantt_chart, I * sizeof(G));
+    commit_checkpoint(sizeof(header) + n * sizeof(Process) + I * sizeof(G));
+}
+
+// Function to restore the engine state from the checkpoint file, returns 0 on success and -1 if there is no usable checkpoint
+int load_checkpoint()
+{
+    Checkpoint_Header header;
+    FILE *file = fopen(CHECKPOINT_FILE, "rb");
+
+    if (file == NULL)
+        return -1;
+
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, "RRQS", 4) != 0
+        || header.n < 0 || header.n > MAX_PROCESS || header.I < 0 || header.I > (int)(sizeof(gantt_chart) / sizeof(G)))
+    {
+        fclose(file);
+        return -1;
+    }
+
+    n = header.n;
+    q = header.q;
+    I = header.I;
+    gantt_truncated = (I == MAX_SLOTS);    // Whether a slot was dropped is not saved, so a full chart stays closed
+    checkpoint_time = header.current_time;
+    checkpoint_completed_processes = header.completed_processes;
+
+    if (fread(processes, sizeof(Process), n, file) != (size_t)n || fread(gantt_chart, sizeof(G), I, file) != (size_t)I)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    fclose(file);
+    resumed = 1;
+    return 0;
+}
+
+// Structure to hold the hot-path counters and phase timers reported by --stats
+typedef struct
+{
+    long long events;       // Iterations of the scheduling loop
+    long long dispatches;   // Times a process was picked to run
+    long long scanned;      // Candidates examined while picking a process
+    long long idle_jumps;   // Jumps of the clock over an idle gap
+    long long sort_swaps;   // Swaps made while sorting by arrival time
+    double sort_time;       // Seconds spent sorting by arrival time
+    double schedule_time;   // Seconds spent in the scheduling loop
+    double output_time;     // Seconds spent printing and writing the results
+} Stats;
+
+Stats stats;    // Counters and timers of the current run
+
+// Function to read the monotonic clock in seconds
+double monotonic_seconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// The counters and timers compile to nothing when ENABLE_STATS is 0
+#if ENABLE_STATS
+#define STAT_ADD(counter, amount) (stats.counter += (amount))
+#define STAT_TIMER_START(timer) double timer##_started = monotonic_seconds()
+#define STAT_TIMER_STOP(timer) (stats.timer += monotonic_seconds() - timer##_started)
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#define STAT_TIMER_START(timer) ((void)0)
+#define STAT_TIMER_STOP(timer) ((void)0)
+#endif
+
+// Function to print the profile of the run collected by the counters and timers
+void print_stats()
+{
+    printf("\nStatistics:\n");
+#if ENABLE_STATS
+    printf("Events processed:     %lld\n", stats.events);
+    printf("Dispatches:           %lld\n", stats.dispatches);
+    printf("Candidates scanned:   %lld\n", stats.scanned);
+    printf("Idle jumps:           %lld\n", stats.idle_jumps);
+    printf("Sort swaps:           %lld\n", stats.sort_swaps);
+    printf("Sort time:            %.6f s\n", stats.sort_time);
+    printf("Scheduling time:      %.6f s\n", stats.schedule_time);
+    printf("Output time:          %.6f s\n", stats.output_time);
+#else
+    printf("Statistics were compiled out, rebuild with ENABLE_STATS set to 1.\n");
+#endif
+}
+
+// Windowed telemetry of the run, recorded by the engine through telemetry_busy and telemetry_completion
+#include "Telemetry.h"
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+// Once the chart is full later slots are dropped, and the last slot only extends until the first one is dropped,
+// so the recorded slots stay an exact prefix of the schedule
+void add_gantt_slot(int process_id, int time)
+{
+    if (!recording_gantt || gantt_truncated)
+        return;
+
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I == MAX_SLOTS)
+    {
+        gantt_truncated = 1;
+    }
+    else
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
 
 // Function to perform Round Robin Scheduling and calculate the completion time, turnaround time and waiting time
 void round_robin_scheduling() 
 {
-    int current_time = 0, completed_processes = 0;  // Track the current time and completed processes
+    int current_time = 0, completed_processes = 0, steps = 0;  // Track the current time and completed processes
 
-    // Initialize remaining time for each process
-    for (int i = 0; i < n; i++) 
+    // When resuming, the processes are already initialized and sorted, so continue from the restored clock
+    if (resumed)
     {
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].completion_time = -1;
+        current_time = checkpoint_time;
+        completed_processes = checkpoint_completed_processes;
     }
-
-    // Sort the processes based on their arrival time using bubble sort
-    for (int i = 0; i < n; i++) 
+    else
     {
-        for (int j = 0; j < n - i - 1; j++) 
+        // Initialize remaining time for each process and start a new Gantt chart, the arrays are reused by every run
+        for (int i = 0; i < n; i++) 
+        {
+            processes[i].remaining_time = processes[i].burst_time;
+            processes[i].completion_time = -1;
+            processes[i].first_run_time = -1;
+        }
+
+        I = 0;
+        gantt_truncated = 0;
+
+        STAT_TIMER_START(sort_time);
+
+        // Sort the processes based on their arrival time using bubble sort, unless an earlier run already did
+        if (!workload_sorted)
         {
-            if (processes[j].arrival_time > processes[j + 1].arrival_time) 
+            for (int i = 0; i < n; i++) 
             {
-                // Swap the processes if their arrival time is in the wrong order
-                Process temp = processes[j];
-                processes[j] = processes[j + 1];
-                processes[j + 1] = temp;
+                for (int j = 0; j < n - i - 1; j++) 
+                {
+                    if (processes[j].arrival_time > processes[j + 1].arrival_time) 
+                    {
+                        // Swap the processes if their arrival time is in the wrong order
+                        Process temp = processes[j];
+                        processes[j] = processes[j + 1];
+                        processes[j + 1] = temp;
+                        STAT_ADD(sort_swaps, 1);
+                    }
+                }
             }
+
+            workload_sorted = 1;
         }
+
+        STAT_TIMER_STOP(sort_time);
     }
 
+    STAT_TIMER_START(schedule_time);
+
     // Process execution with round robin scheduling
     while (completed_processes < n) 
     {
+        STAT_ADD(events, 1);
+
+        // Periodically save the engine state so an interrupted run can be resumed
+        if (++steps % CHECKPOINT_INTERVAL == 0)
+            save_checkpoint(current_time, completed_processes);
+
         int executed = 0;
 
         // Find the process ready to execute
@@ -63,43 +285,57 @@ void round_robin_scheduling()
         {
             if (processes[i].arrival_time <= current_time && processes[i].remaining_time > 0) 
             {
-                if (processes[i].remaining_time > q) 
-                {
-                    current_time += q;
-                    processes[i].remaining_time -= q;
-                } 
-                else 
+                STAT_ADD(dispatches, 1);
+
+                int start_time = current_time;  // Start of this time slice
+
+                // Record the first dispatch of the process for its response time
+                if (processes[i].first_run_time == -1)
                 {
-                    current_time += processes[i].remaining_time;
-                    processes[i].remaining_time = 0;
-                    processes[i].completion_time = current_time;
-                    processes[i].turn_around_time = processes[i].completion_time - processes[i].arrival_time;
-                    processes[i].waiting_time = processes[i].turn_around_time - processes[i].burst_time;
-                    completed_processes++;
+                    processes[i].first_run_time = current_time;
                 }
+
+                // Run the process for one quantum, or less if it finishes earlier
+                if (run_quantum(&processes[i], &current_time, q))
+                    completed_processes++;
                 executed = 1;
 
-                if (I == 0 || gantt_chart[I-1].process_id != processes[i].process_id)
-                {
-                    gantt_chart[I].process_id = processes[i].process_id;
-                    gantt_chart[I].time = current_time;
-                    I++;
-                }
-                else
-                {
-                    gantt_chart[I-1].time = current_time;
-                }
+                // Record the time slice in the telemetry windows
+                telemetry_busy(start_time, current_time);
+                if (processes[i].remaining_time == 0)
+                    telemetry_completion(current_time);
+
+                add_gantt_slot(processes[i].process_id, current_time);
             }
         }
 
+        STAT_ADD(scanned, n);
+
+        // If no process was ready, the CPU is idle until the next arrival, so jump straight to it
         if (!executed)
         {
-            gantt_chart[I].process_id = -1;
-            gantt_chart[I].time = current_time;
-            I++;
-            current_time ++;
+            int next_arrival = __INT_MAX__;
+
+            // The processes are sorted by arrival time, so the first unfinished one arrives next
+            for (int i = 0; i < n; i++)
+            {
+                if (processes[i].remaining_time > 0)
+                {
+                    next_arrival = processes[i].arrival_time;
+                    break;
+                }
+            }
+
+            // Represent the whole idle period as a single slot in the Gantt chart
+            add_gantt_slot(-1, next_arrival);
+            current_time = next_arrival;
+            STAT_ADD(idle_jumps, 1);
         }
     }
+
+    STAT_TIMER_STOP(schedule_time);
+
+    finish_checkpoints();   // The run is complete, so its checkpoint is no longer needed
 }
 
 // Function to calculate the average turnaround time
@@ -109,7 +345,7 @@ float calculate_average_turnaround_time()
 
     // Calculate the sum of all turnaround times
     for (int i = 0; i < n; i++)
-        total_turnaround_time += processes[i].turn_around_time;
+        total_turnaround_time += turn_around_time(&processes[i]);
 
     return (float)total_turnaround_time / n;    // Return the average turnaround time
 }
@@ -121,11 +357,49 @@ float calculate_average_waiting_time()
 
     // Calculate the sum of all waiting times
     for (int i = 0; i < n; i++)
-        total_waiting_time += processes[i].waiting_time;
+        total_waiting_time += waiting_time(&processes[i]);
 
     return (float)total_waiting_time / n;   // Return the average waiting time
 }
 
+// Function to calculate the average response time
+float calculate_average_response_time()
+{
+    int total_response_time = 0;    // Variable to store total response time
+
+    // Calculate the sum of all response times
+    for (int i = 0; i < n; i++)
+        total_response_time += response_time(&processes[i]);
+
+    return (float)total_response_time / n;  // Return the average response time
+}
+
+// Function to calculate a percentile of the response times using the nearest-rank method, 0 when there are no processes
+int calculate_response_time_percentile(int percentile)
+{
+    int sorted[MAX_PROCESS];    // Response times in increasing order
+
+    if (n == 0)
+        return 0;
+
+    // Sort a copy of the response times using insertion sort
+    for (int i = 0; i < n; i++)
+    {
+        int j = i;
+
+        while (j > 0 && sorted[j - 1] > response_time(&processes[i]))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = response_time(&processes[i]);
+    }
+
+    int rank = (percentile * n + 99) / 100;    // Smallest rank covering the percentile
+
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
 // Function to print the Gantt Chart (graphical representation of process execution)
 void print_gantt_chart()
 {
@@ -142,7 +416,14 @@ void print_gantt_chart()
     // Print the process IDs in the Gantt chart
     for (int i = 0; i < I; i++)
     {
-        printf("  P%d   |", gantt_chart[i].process_id);
+        if (gantt_chart[i].process_id == -1) 
+        {
+            printf("\t|");
+        } 
+        else 
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
     }
 
     printf("\n ");
@@ -160,6 +441,9 @@ void print_gantt_chart()
         printf("\t%d", gantt_chart[i].time);
     }
     printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
 }
 
 // Function to print the resultant table (showing process details)
@@ -168,44 +452,378 @@ void print_resultant_table()
     printf("\nResultant Table:\n");
 
     // Print the table header with column names
-    printf("-------------------------------------------------------------------------------------------------\n");
-    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |\n");
-    printf("-------------------------------------------------------------------------------------------------\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |     R . T     |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
 
     // Print process information for each process
     for (int i = 0; i < n; i++)
-        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n", 
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n", 
             processes[i].process_id, 
             processes[i].arrival_time, 
             processes[i].burst_time, 
             processes[i].completion_time, 
-            processes[i].turn_around_time, 
-            processes[i].waiting_time
+            turn_around_time(&processes[i]), 
+            waiting_time(&processes[i]),
+            response_time(&processes[i])
         );
 
-    printf("-------------------------------------------------------------------------------------------------\n");    
+    printf("-----------------------------------------------------------------------------------------------------------------\n");    
+}
+
+#include "Gantt_Renderer.h"     // Streaming SVG renderer used by write_gantt_chart
+
+// Function to write the Gantt chart to a file as an SVG drawing, or as an HTML page when html is set
+// Returns 0 on success and -1 if the file cannot be opened or written
+int write_gantt_chart(const char *path, int html)
+{
+    FILE *file = fopen(path, "w");
+    Gantt_Renderer renderer;
+
+    if (file == NULL)
+        return -1;
+
+    int end_time = (I > 0) ? gantt_chart[I - 1].time : 1;
+
+    begin_gantt_drawing(&renderer, file, end_time, html);
+
+    // Each slot ends at its recorded time and starts where the previous slot ended, idle slots are left blank
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id != -1)
+            render_gantt_segment(&renderer, gantt_chart[i].process_id, (i > 0) ? gantt_chart[i - 1].time : 0, gantt_chart[i].time);
+    }
+
+    return end_gantt_drawing(&renderer, end_time, html);
 }
 
+// Column names of the resultant table, in the order they are written
+const char *result_columns[RESULT_COLUMNS] = {
+    "process_id",
+    "arrival_time",
+    "burst_time",
+    "completion_time",
+    "turn_around_time",
+    "waiting_time",
+    "response_time"
+};
+
+// Function to fill the columns of row i of the resultant table
+void result_row(int i, int values[])
+{
+    values[0] = processes[i].process_id;
+    values[1] = processes[i].arrival_time;
+    values[2] = processes[i].burst_time;
+    values[3] = processes[i].completion_time;
+    values[4] = turn_around_time(&processes[i]);
+    values[5] = waiting_time(&processes[i]);
+    values[6] = response_time(&processes[i]);
+}
+
+#include "Result_Writer.h"      // write_results, writing the rows filled by result_row
+#include "Workload_Reader.h"    // load_workload, reading the files written by Trace_Import_in_C.c
+
+const char *metric_names[MONTE_CARLO_METRICS] = { "Average Turnaround Time", "Average Waiting Time", "Average Response Time" };
+
+// Function to run the engine on a Monte Carlo replica and collect its metrics
+void replica_engine(double metrics[])
+{
+    workload_sorted = 1;    // The workload is generated in arrival order
+    round_robin_scheduling();
+
+    metrics[0] = calculate_average_turnaround_time();
+    metrics[1] = calculate_average_waiting_time();
+    metrics[2] = calculate_average_response_time();
+}
+
+#include "Monte_Carlo.h"        // monte_carlo, running the replicas in worker processes
+#include "Result_Cache.h"       // cache_lookup and cache_store, keyed by workload_key
+#include "Busy_Periods.h"       // run_busy_periods, simulating the busy periods in worker processes
+
 // Main function: Entry point of the program
-int main()
+int main(int argc, char *argv[])
 {
-    // Input the number of processes and the quantum number from the user
-    printf("Enter the number of processes: ");
-    scanf("%d", &n);
-    printf("Enter the quantum number: ");
-    scanf("%d", &q);
+    const char *output_path = NULL;     // File for the machine-readable results, if requested
+    int output_format = FORMAT_CSV;     // Format of the machine-readable results
+    const char *gantt_path = NULL;      // File for the drawn Gantt chart, if requested
+    int gantt_html = 0;                 // Set when the Gantt chart is drawn as an HTML page
+    int show_stats = 0;                 // Set by --stats
+    const char *telemetry_path = NULL;  // File for the windowed telemetry, if requested
+    int window_width = 10;              // Width of a telemetry window in units of time
+    const char *workload_path = NULL;   // Binary workload to read instead of the interactive input, if requested
+    const char *cache_dir = NULL;       // Directory of cached results, if requested
+    int busy_workers = 0;               // Worker processes of --busy-periods, 0 to run the engine once over the whole workload
+    int sweep = 0;                      // Set by --sweep
+    int sweep_from = 0, sweep_to = 0;   // Range of quanta to sweep over the same workload
+    int replicas = 0;                   // Number of Monte Carlo replicas, 0 for a single interactive run
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN);  // Number of worker processes running replicas in parallel
+    double precision = 0.01;            // Relative half-width of the 95% confidence intervals that stops Monte Carlo early
+    unsigned long long seed = 1;        // Seed of the Monte Carlo workloads, a fixed default keeps runs reproducible
+    int resume = 0;                     // Set by --resume
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--resume") == 0)
+        {
+            resume = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--checkpoint-interval") == 0)
+        {
+            checkpoint_period = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--stats") == 0)
+        {
+            show_stats = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--monte-carlo") == 0)
+        {
+            replicas = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workers") == 0)
+        {
+            workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--precision") == 0)
+        {
+            precision = atof(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (i + 2 < argc && strcmp(argv[i], "--sweep") == 0)
+        {
+            sweep = 1;
+            sweep_from = atoi(argv[++i]);
+            sweep_to = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--cache") == 0)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--busy-periods") == 0)
+        {
+            busy_workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--telemetry") == 0)
+        {
+            telemetry_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--window") == 0)
+        {
+            window_width = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--csv") == 0)
+        {
+            output_format = FORMAT_CSV;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--jsonl") == 0)
+        {
+            output_format = FORMAT_JSONL;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--binary") == 0)
+        {
+            output_format = FORMAT_BINARY;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && (strcmp(argv[i], "--svg") == 0 || strcmp(argv[i], "--html") == 0))
+        {
+            gantt_html = (strcmp(argv[i], "--html") == 0);
+            gantt_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
 
-    // Input the arrival and burst times for each process
-    for (int i = 0; i < n; i++)
+    if (window_width <= 0)
+    {
+        printf("Telemetry window width must be positive.\n");
+        return 1;
+    }
+
+    if (busy_workers < 0 || busy_workers > MAX_BUSY_WORKERS)
+    {
+        printf("Number of busy period workers must be between 1 and %d.\n", MAX_BUSY_WORKERS);
+        return 1;
+    }
+
+    // The engine records the telemetry and the counters in the workers, where they would be lost
+    if (busy_workers > 0 && (telemetry_path != NULL || show_stats || resume || replicas > 0 || sweep))
+    {
+        printf("--busy-periods cannot be combined with --telemetry, --stats, --resume, --monte-carlo, --sweep.\n");
+        return 1;
+    }
+
+    if (checkpoint_period < 0)
+    {
+        printf("Checkpoint interval must not be negative.\n");
+        return 1;
+    }
+
+    // The engine itself feeds the telemetry, and a resumed run depends on the checkpoint as well as the workload, so neither is cached
+    if (telemetry_path != NULL || resume)
+        cache_dir = NULL;
+
+    // Monte Carlo mode: simulate many random workloads drawn from a distribution instead of one entered workload
+    if (replicas > 0)
+    {
+        double mean_interarrival, mean_burst;
+
+        if (replicas > MAX_REPLICAS || workers < 1 || precision < 0)
+        {
+            printf("Replicas must be at most %d, workers positive and the precision not negative.\n", MAX_REPLICAS);
+            return 1;
+        }
+
+        if (workers > MAX_WORKERS)
+            workers = MAX_WORKERS;
+
+        checkpointing = 0;
+        recording_gantt = 0;    // The replicas only report their averages
+
+        printf("Enter the number of processes per replica: ");
+        scanf("%d", &n);
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+        printf("Enter the mean inter-arrival time (exponential): ");
+        scanf("%lf", &mean_interarrival);
+        printf("Enter the mean burst time (exponential): ");
+        scanf("%lf", &mean_burst);
+
+        if (n < 1 || n > MAX_PROCESS || q <= 0 || mean_interarrival < 0 || mean_burst <= 0)
+        {
+            printf("Number of processes must be between 1 and %d, and the times must be positive.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        if (monte_carlo(replicas, workers, precision, seed, mean_interarrival, mean_burst) == -1)
+        {
+            printf("Could not run the replicas.\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // With --resume, continue the interrupted run saved in the checkpoint file instead of reading new input
+    if (resume)
+    {
+        if (load_checkpoint() == -1)
+        {
+            printf("No usable checkpoint found in %s.\n", CHECKPOINT_FILE);
+            return 1;
+        }
+    }
+    else if (workload_path != NULL)
+    {
+        if (load_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of 1 to %d processes from %s.\n", MAX_PROCESS, workload_path);
+            return 1;
+        }
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+    }
+    else
+    {
+        // Input the number of processes and the quantum number from the user
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        // Input the arrival and burst times for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+        }
+    }
+
+    // Sweep mode: run the same workload once per quantum and print one line of averages per run
+    // Every run reuses the process array, the Gantt chart and the arrival order sorted by the first run
+    if (sweep)
+    {
+        if (sweep_from <= 0 || sweep_to < sweep_from || resume)
+        {
+            printf("The sweep needs 0 < FROM <= TO and cannot be combined with --resume.\n");
+            return 1;
+        }
+
+        checkpointing = 0;
+        recording_gantt = 0;    // Only the averages of every quantum are printed
+
+        for (q = sweep_from; q <= sweep_to; q++)
+        {
+            round_robin_scheduling();
+            printf("Quantum %d: Average Turnaround Time: %.2f, Average Waiting Time: %.2f, Average Response Time: %.2f\n",
+                q, calculate_average_turnaround_time(), calculate_average_waiting_time(), calculate_average_response_time());
+        }
+
+        if (show_stats)
+            print_stats();
+
+        return 0;
+    }
+
+    // Start the windowed telemetry if requested, the engine feeds it while it runs
+    if (telemetry_path != NULL && begin_telemetry(telemetry_path, window_width) == -1)
+    {
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
+    }
+
+    unsigned long long cache_key = (cache_dir != NULL) ? workload_key() : 0;   // Key of the cached result, taken before the engine reorders the processes
+
+    // Reuse the cached result of the same workload and parameters if there is one, otherwise run the engine and cache its result
+    if (cache_dir != NULL && cache_lookup(cache_dir, cache_key) == 0)
+    {
+        printf("\nResult loaded from the cache.\n");
+    }
+    else
+    {
+        // With --busy-periods, simulate the busy periods in worker processes instead of running the engine once
+        if (busy_workers > 0)
+        {
+            checkpointing = 0;  // The workers see single periods, which are never resumed
+            int periods = run_busy_periods(busy_workers);
+
+            if (periods == -1)
+            {
+                printf("Could not simulate the busy periods in worker processes.\n");
+                return 1;
+            }
+            printf("\nSimulated %d busy periods on %d worker processes.\n", periods, (busy_workers < periods) ? busy_workers : periods);
+        }
+        else
+        {
+            round_robin_scheduling();   // Perform the Round Robin Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+        }
+
+        if (cache_dir != NULL && cache_store(cache_dir, cache_key) == -1)
+            printf("Could not write the result to the cache in %s.\n", cache_dir);
+    }
+
+    if (end_telemetry() == -1)
     {
-        processes[i].process_id = i + 1;
-        printf("Enter the arrival time of P%d: ", i + 1);
-        scanf("%d", &processes[i].arrival_time);
-        printf("Enter the burst time of P%d: ", i + 1);
-        scanf("%d", &processes[i].burst_time);
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
     }
 
-    round_robin_scheduling();   // Perform the Round Robin Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+    STAT_TIMER_START(output_time);
 
     print_gantt_chart();        // Print the Gantt chart
     
@@ -214,6 +832,29 @@ int main()
     // Print the average turnaround time and waiting time
     printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
     printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+    printf("Average Response Time: %.2f\n", calculate_average_response_time());
+    printf("Response Time Percentiles: p50 = %d, p90 = %d, p99 = %d\n",
+        calculate_response_time_percentile(50), calculate_response_time_percentile(90), calculate_response_time_percentile(99));
+
+    // Write the results in the requested machine-readable format
+    if (output_path != NULL && write_results(output_path, output_format) == -1)
+    {
+        printf("Could not write the results to %s.\n", output_path);
+        return 1;
+    }
+
+    // Draw the Gantt chart to a file if requested
+    if (gantt_path != NULL && write_gantt_chart(gantt_path, gantt_html) == -1)
+    {
+        printf("Could not write the Gantt chart to %s.\n", gantt_path);
+        return 1;
+    }
+
+    STAT_TIMER_STOP(output_time);
+
+    // Print where the run spent its time if requested
+    if (show_stats)
+        print_stats();
 
     return 0;   // Return 0 to indicate successful execution
 }
@@ -1,6 +1,20 @@
+#define _DEFAULT_SOURCE  // clock_gettime, futimens and kill are POSIX, declare them under -std=c11 as well
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <math.h>
+#include <sys/wait.h>
 
 #define MAX_PROCESS 10  // Maximum number of processes
+#define MAX_HISTORY 10  // Maximum number of previous bursts per process used for burst prediction
+#define ENABLE_STATS 1  // Set to 0 to compile the hot-path counters and timers out of the engine
+#define RESULT_COLUMNS 6  // Number of columns in the resultant table
+#define CACHE_TAG "SJF"  // Name of the policy in the cache key, so programs sharing a cache directory never mix results
+#define BUSY_PERIODS_ENGINE() sjf_scheduling()  // Engine run by --busy-periods on every busy period
+#define BUSY_PERIODS_GANTT_INDICES  // The Gantt chart holds indices into the process array
+#define MONTE_CARLO_METRICS 2  // Metrics collected per replica: average turnaround and waiting time
 
 // Structure to represent a process
 typedef struct 
@@ -9,17 +23,126 @@ typedef struct
     int arrival_time;       // Arrival time of the process
     int burst_time;         // Burst time (time required for execution)
     int completion_time;    // Time at which the process finishes execution
-    int turn_around_time;   // Turnaround time = Completion time - Arrival time
-    int waiting_time;       // Waiting time = Turnaround time - Burst time
     int remaining_time;     // Remaining time for the process during execution
+    int predicted_burst;    // Estimated burst time used for scheduling in predictive mode
 } Process;
 
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
 Process processes[MAX_PROCESS];   // Declare an array of processes with a maximum size of 10
 
 int gantt_chart[MAX_PROCESS], I = 0;   // Array to store the order of processes in the Gantt chart and a counter variable
 
 int n;  // Global variable to store the number of processes
 
+int predictive = 0;                             // Set by --predict: schedule on estimated bursts instead of the true ones
+float alpha = 0.5f;                             // Weight of the most recent burst in the exponential average
+float initial_estimate = 10;                    // Estimate used before any burst has been observed
+int burst_history[MAX_HISTORY][MAX_PROCESS];    // Previous bursts, burst_history[k][i] is the k-th oldest burst of process i
+int history_length[MAX_PROCESS];               // Number of previous bursts of each process
+
+// Structure to hold the hot-path counters and phase timers reported by --stats
+typedef struct
+{
+    long long events;       // Iterations of the scheduling loop
+    long long dispatches;   // Times a process was picked to run
+    long long scanned;      // Candidates examined while picking a process
+    long long idle_jumps;   // Jumps of the clock over an idle gap
+    long long sort_swaps;   // Swaps made while sorting by arrival time
+    double sort_time;       // Seconds spent sorting by arrival time
+    double schedule_time;   // Seconds spent in the scheduling loop
+    double output_time;     // Seconds spent printing and writing the results
+} Stats;
+
+Stats stats;    // Counters and timers of the current run
+
+// Function to read the monotonic clock in seconds
+double monotonic_seconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// The counters and timers compile to nothing when ENABLE_STATS is 0
+#if ENABLE_STATS
+#define STAT_ADD(counter, amount) (stats.counter += (amount))
+#define STAT_TIMER_START(timer) double timer##_started = monotonic_seconds()
+#define STAT_TIMER_STOP(timer) (stats.timer += monotonic_seconds() - timer##_started)
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#define STAT_TIMER_START(timer) ((void)0)
+#define STAT_TIMER_STOP(timer) ((void)0)
+#endif
+
+// Function to print the profile of the run collected by the counters and timers
+void print_stats()
+{
+    printf("\nStatistics:\n");
+#if ENABLE_STATS
+    printf("Events processed:     %lld\n", stats.events);
+    printf("Dispatches:           %lld\n", stats.dispatches);
+    printf("Candidates scanned:   %lld\n", stats.scanned);
+    printf("Idle jumps:           %lld\n", stats.idle_jumps);
+    printf("Sort swaps:           %lld\n", stats.sort_swaps);
+    printf("Sort time:            %.6f s\n", stats.sort_time);
+    printf("Scheduling time:      %.6f s\n", stats.schedule_time);
+    printf("Output time:          %.6f s\n", stats.output_time);
+#else
+    printf("Statistics were compiled out, rebuild with ENABLE_STATS set to 1.\n");
+#endif
+}
+
+// Windowed telemetry of the run, recorded by the engine through telemetry_busy and telemetry_completion
+#include "Telemetry.h"
+
+// Function to estimate the next burst of every process by exponential averaging over its previous bursts
+// tau = alpha * t + (1 - alpha) * tau, starting from initial_estimate. The history is stored one position per row,
+// so the inner loop is a branch-free pass over contiguous arrays that the compiler can vectorize
+void estimate_bursts()
+{
+    float tau[MAX_PROCESS];
+    int longest_history = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        tau[i] = initial_estimate;
+
+        if (history_length[i] > longest_history)
+            longest_history = history_length[i];
+    }
+
+    for (int k = 0; k < longest_history; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            float updated = alpha * burst_history[k][i] + (1 - alpha) * tau[i];
+            tau[i] = (k < history_length[i]) ? updated : tau[i];
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+        processes[i].predicted_burst = (int)(tau[i] + 0.5f);
+}
+
+// Function to return the burst time the scheduler sees for a process: the true one, or the estimate in predictive mode
+// Completion, turnaround and waiting times always use the true burst time
+int scheduling_key(int i)
+{
+    return predictive ? processes[i].predicted_burst : processes[i].remaining_time;
+}
+
 // Function to perform SJF scheduling and calculate completion time, turnaround time and waiting time for each process
 void sjf_scheduling()
 {
@@ -32,43 +155,60 @@ void sjf_scheduling()
     }
 
     // Execute the processes using a scheduling algorithm (Shortest Job First)
+    STAT_TIMER_START(schedule_time);
+
     while (completed_processes < n) 
     {
+        STAT_ADD(events, 1);
         min_burst_time = __INT_MAX__;   // Initialize with maximum integer value
         shortest_process = -1;          // Initialize to an invalid index
 
         // Find the process with the shortest remaining time and which has arrived
         for (int i = 0; i < n; i++) 
         {
-            if (processes[i].arrival_time <= current_time && processes[i].remaining_time < min_burst_time && processes[i].remaining_time > 0) 
+            if (processes[i].arrival_time <= current_time && scheduling_key(i) < min_burst_time && processes[i].remaining_time > 0) 
             {
-                min_burst_time = processes[i].remaining_time;
+                min_burst_time = scheduling_key(i);
                 shortest_process = i;
             }
         }
+        STAT_ADD(scanned, n);
 
-        // If no process is ready to execute, increment the current time
+        // If no process is ready to execute, the CPU is idle until the next arrival, so jump straight to it
         if (shortest_process == -1) 
         {
-            current_time++;
+            int next_arrival = __INT_MAX__;
+
+            for (int i = 0; i < n; i++)
+            {
+                if (processes[i].remaining_time > 0 && processes[i].arrival_time < next_arrival)
+                    next_arrival = processes[i].arrival_time;
+            }
+
+            current_time = next_arrival;
+            STAT_ADD(idle_jumps, 1);
             continue;
         }
 
+        STAT_ADD(dispatches, 1);
+
         // Update the process details after executing the selected process
         current_time += processes[shortest_process].burst_time;
         processes[shortest_process].remaining_time = 0;
         processes[shortest_process].completion_time = current_time;
 
-        // Calculate turnaround time and waiting time
-        processes[shortest_process].turn_around_time = processes[shortest_process].completion_time - processes[shortest_process].arrival_time;
-        processes[shortest_process].waiting_time = processes[shortest_process].turn_around_time - processes[shortest_process].burst_time;
-
         completed_processes++;  // Increment the count of completed processes
 
+        // Record the execution in the telemetry windows
+        telemetry_busy(current_time - processes[shortest_process].burst_time, current_time);
+        telemetry_completion(current_time);
+
         // Store the process ID in the Gantt chart order array
         gantt_chart[I] = shortest_process;
         I++;
     }
+
+    STAT_TIMER_STOP(schedule_time);
 }
 
 // Function to calculate average turnaround time
@@ -78,7 +218,7 @@ float calculate_average_turnaround_time()
 
     // Calculate the sum of all turnaround times
     for (int i = 0; i < n; i++)
-        total_turnaround_time += processes[i].turn_around_time;
+        total_turnaround_time += turn_around_time(&processes[i]);
 
     return (float)total_turnaround_time / n;    // Return the average turnaround time
 }
@@ -90,7 +230,7 @@ float calculate_average_waiting_time()
 
     // Calculate the sum of all waiting times
     for (int i = 0; i < n; i++)
-        total_waiting_time += processes[i].waiting_time;
+        total_waiting_time += waiting_time(&processes[i]);
 
     return (float)total_waiting_time / n;   // Return the average waiting time
 }
@@ -112,8 +252,8 @@ void print_resultant_table()
             processes[i].arrival_time, 
             processes[i].burst_time, 
             processes[i].completion_time, 
-            processes[i].turn_around_time, 
-            processes[i].waiting_time
+            turn_around_time(&processes[i]), 
+            waiting_time(&processes[i])
         );
 
     printf("-------------------------------------------------------------------------------------------------\n");    
@@ -176,24 +316,333 @@ void print_gantt_chart()
 }
 
 
+#include "Gantt_Renderer.h"     // Streaming SVG renderer used by write_gantt_chart
+
+// Function to write the Gantt chart to a file as an SVG drawing, or as an HTML page when html is set
+// Returns 0 on success and -1 if the file cannot be opened or written
+int write_gantt_chart(const char *path, int html)
+{
+    FILE *file = fopen(path, "w");
+    Gantt_Renderer renderer;
+
+    if (file == NULL)
+        return -1;
+
+    int end_time = (I > 0) ? processes[gantt_chart[I - 1]].completion_time : 1;
+
+    begin_gantt_drawing(&renderer, file, end_time, html);
+
+    for (int i = 0; i < I; i++)
+        render_gantt_segment(&renderer, processes[gantt_chart[i]].process_id, processes[gantt_chart[i]].completion_time - processes[gantt_chart[i]].burst_time, processes[gantt_chart[i]].completion_time);
+
+    return end_gantt_drawing(&renderer, end_time, html);
+}
+
+// Column names of the resultant table, in the order they are written
+const char *result_columns[RESULT_COLUMNS] = {
+    "process_id",
+    "arrival_time",
+    "burst_time",
+    "completion_time",
+    "turn_around_time",
+    "waiting_time"
+};
+
+// Function to fill the columns of row i of the resultant table
+void result_row(int i, int values[])
+{
+    values[0] = processes[i].process_id;
+    values[1] = processes[i].arrival_time;
+    values[2] = processes[i].burst_time;
+    values[3] = processes[i].completion_time;
+    values[4] = turn_around_time(&processes[i]);
+    values[5] = waiting_time(&processes[i]);
+}
+
+#include "Result_Writer.h"      // write_results, writing the rows filled by result_row
+#include "Workload_Reader.h"    // load_workload, reading the files written by Trace_Import_in_C.c
+
+const char *metric_names[MONTE_CARLO_METRICS] = { "Average Turnaround Time", "Average Waiting Time" };
+
+// Function to run the engine on a Monte Carlo replica and collect its metrics
+void replica_engine(double metrics[])
+{
+    I = 0;
+    sjf_scheduling();
+
+    metrics[0] = calculate_average_turnaround_time();
+    metrics[1] = calculate_average_waiting_time();
+}
+
+#include "Monte_Carlo.h"        // monte_carlo, running the replicas in worker processes
+#include "Result_Cache.h"       // cache_lookup and cache_store, keyed by workload_key
+#include "Busy_Periods.h"       // run_busy_periods, simulating the busy periods in worker processes
+
 // Main function: Entry point of the program
-int main()
+int main(int argc, char *argv[])
 {
-    // Input the number of processes
-    printf("Enter the number of processes: ");
-    scanf("%d", &n);
+    const char *output_path = NULL;     // File for the machine-readable results, if requested
+    int output_format = FORMAT_CSV;     // Format of the machine-readable results
+    const char *gantt_path = NULL;      // File for the drawn Gantt chart, if requested
+    int gantt_html = 0;                 // Set when the Gantt chart is drawn as an HTML page
+    int show_stats = 0;                 // Set by --stats
+    const char *telemetry_path = NULL;  // File for the windowed telemetry, if requested
+    int window_width = 10;              // Width of a telemetry window in units of time
+    const char *workload_path = NULL;   // Binary workload to read instead of the interactive input, if requested
+    const char *cache_dir = NULL;       // Directory of cached results, if requested
+    int busy_workers = 0;               // Worker processes of --busy-periods, 0 to run the engine once over the whole workload
+    int replicas = 0;                   // Number of Monte Carlo replicas, 0 for a single interactive run
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN);  // Number of worker processes running replicas in parallel
+    double precision = 0.01;            // Relative half-width of the 95% confidence intervals that stops Monte Carlo early
+    unsigned long long seed = 1;        // Seed of the Monte Carlo workloads, a fixed default keeps runs reproducible
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--predict") == 0)
+        {
+            predictive = 1;
+        }
+        else if (strcmp(argv[i], "--stats") == 0)
+        {
+            show_stats = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--monte-carlo") == 0)
+        {
+            replicas = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workers") == 0)
+        {
+            workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--precision") == 0)
+        {
+            precision = atof(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--cache") == 0)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--busy-periods") == 0)
+        {
+            busy_workers = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--telemetry") == 0)
+        {
+            telemetry_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--window") == 0)
+        {
+            window_width = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--csv") == 0)
+        {
+            output_format = FORMAT_CSV;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--jsonl") == 0)
+        {
+            output_format = FORMAT_JSONL;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--binary") == 0)
+        {
+            output_format = FORMAT_BINARY;
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && (strcmp(argv[i], "--svg") == 0 || strcmp(argv[i], "--html") == 0))
+        {
+            gantt_html = (strcmp(argv[i], "--html") == 0);
+            gantt_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
 
-    // Input the arrival and burst times for each process
-    for (int i = 0; i < n; i++)
+    if (window_width <= 0)
+    {
+        printf("Telemetry window width must be positive.\n");
+        return 1;
+    }
+
+    if (busy_workers < 0 || busy_workers > MAX_BUSY_WORKERS)
+    {
+        printf("Number of busy period workers must be between 1 and %d.\n", MAX_BUSY_WORKERS);
+        return 1;
+    }
+
+    // The engine records the telemetry and the counters in the workers, where they would be lost
+    if (busy_workers > 0 && (telemetry_path != NULL || show_stats || replicas > 0))
+    {
+        printf("--busy-periods cannot be combined with --telemetry, --stats, --monte-carlo.\n");
+        return 1;
+    }
+
+    // The engine itself feeds the telemetry, and a predicted run depends on the burst history as well as the workload, so neither is cached
+    if (telemetry_path != NULL || predictive)
+        cache_dir = NULL;
+
+    // Monte Carlo mode: simulate many random workloads drawn from a distribution instead of one entered workload
+    if (replicas > 0)
+    {
+        double mean_interarrival, mean_burst;
+
+        if (predictive)
+        {
+            printf("--predict cannot be combined with --monte-carlo.\n");
+            return 1;
+        }
+
+        if (replicas > MAX_REPLICAS || workers < 1 || precision < 0)
+        {
+            printf("Replicas must be at most %d, workers positive and the precision not negative.\n", MAX_REPLICAS);
+            return 1;
+        }
+
+        if (workers > MAX_WORKERS)
+            workers = MAX_WORKERS;
+
+        printf("Enter the number of processes per replica: ");
+        scanf("%d", &n);
+        printf("Enter the mean inter-arrival time (exponential): ");
+        scanf("%lf", &mean_interarrival);
+        printf("Enter the mean burst time (exponential): ");
+        scanf("%lf", &mean_burst);
+
+        if (n < 1 || n > MAX_PROCESS || mean_interarrival < 0 || mean_burst <= 0)
+        {
+            printf("Number of processes must be between 1 and %d, and the times must be positive.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        if (monte_carlo(replicas, workers, precision, seed, mean_interarrival, mean_burst) == -1)
+        {
+            printf("Could not run the replicas.\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Predictions are built from the previous bursts of every process, which a workload file does not hold
+    if (predictive && workload_path != NULL)
+    {
+        printf("--predict cannot be combined with --workload.\n");
+        return 1;
+    }
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of 1 to %d processes from %s.\n", MAX_PROCESS, workload_path);
+            return 1;
+        }
+    }
+    else
+    {
+        // Input the number of processes
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // In predictive mode, input the parameters of the exponential average
+        if (predictive)
+        {
+            printf("Enter the weight alpha of the most recent burst (0 to 1): ");
+            scanf("%f", &alpha);
+            printf("Enter the initial burst estimate: ");
+            scanf("%f", &initial_estimate);
+        }
+
+        // Input the arrival and burst times for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+
+            // In predictive mode, input the previous bursts the estimate is built from
+            if (predictive)
+            {
+                printf("Enter the number of previous bursts of P%d (at most %d): ", i + 1, MAX_HISTORY);
+                scanf("%d", &history_length[i]);
+
+                if (history_length[i] < 0 || history_length[i] > MAX_HISTORY)
+                {
+                    printf("Number of previous bursts must be between 0 and %d.\n", MAX_HISTORY);
+                    return 1;
+                }
+
+                for (int k = 0; k < history_length[i]; k++)
+                {
+                    printf("Enter previous burst %d of P%d (oldest first): ", k + 1, i + 1);
+                    scanf("%d", &burst_history[k][i]);
+                }
+            }
+        }
+
+        if (predictive)
+            estimate_bursts();
+    }
+
+    // Start the windowed telemetry if requested, the engine feeds it while it runs
+    if (telemetry_path != NULL && begin_telemetry(telemetry_path, window_width) == -1)
     {
-        processes[i].process_id = i + 1;
-        printf("Enter the arrival time of P%d: ", i + 1);
-        scanf("%d", &processes[i].arrival_time);
-        printf("Enter the burst time of P%d: ", i + 1);
-        scanf("%d", &processes[i].burst_time);
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
     }
 
-    sjf_scheduling();           // Perform the SJF scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+    unsigned long long cache_key = (cache_dir != NULL) ? workload_key() : 0;   // Key of the cached result, taken before the engine reorders the processes
+
+    // Reuse the cached result of the same workload and parameters if there is one, otherwise run the engine and cache its result
+    if (cache_dir != NULL && cache_lookup(cache_dir, cache_key) == 0)
+    {
+        printf("\nResult loaded from the cache.\n");
+    }
+    else
+    {
+        // With --busy-periods, simulate the busy periods in worker processes instead of running the engine once
+        if (busy_workers > 0)
+        {
+            int periods = run_busy_periods(busy_workers);
+
+            if (periods == -1)
+            {
+                printf("Could not simulate the busy periods in worker processes.\n");
+                return 1;
+            }
+            printf("\nSimulated %d busy periods on %d worker processes.\n", periods, (busy_workers < periods) ? busy_workers : periods);
+        }
+        else
+        {
+            sjf_scheduling();           // Perform the SJF scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+        }
+
+        if (cache_dir != NULL && cache_store(cache_dir, cache_key) == -1)
+            printf("Could not write the result to the cache in %s.\n", cache_dir);
+    }
+
+    if (end_telemetry() == -1)
+    {
+        printf("Could not write the telemetry to %s.\n", telemetry_path);
+        return 1;
+    }
+
+    STAT_TIMER_START(output_time);
 
     print_gantt_chart();        // Print the Gantt chart
     
@@ -203,5 +652,34 @@ int main()
     printf("\nAverage Turnaround Time: %f\n", calculate_average_turnaround_time());
     printf("Average Waiting Time: %f\n", calculate_average_waiting_time());
 
+    // In predictive mode, show the estimates the schedule was built on
+    if (predictive)
+    {
+        printf("\nPredicted Burst Times:");
+        for (int i = 0; i < n; i++)
+            printf(" P%d = %d", processes[i].process_id, processes[i].predicted_burst);
+        printf("\n");
+    }
+
+    // Write the results in the requested machine-readable format
+    if (output_path != NULL && write_results(output_path, output_format) == -1)
+    {
+        printf("Could not write the results to %s.\n", output_path);
+        return 1;
+    }
+
+    // Draw the Gantt chart to a file if requested
+    if (gantt_path != NULL && write_gantt_chart(gantt_path, gantt_html) == -1)
+    {
+        printf("Could not write the Gantt chart to %s.\n", gantt_path);
+        return 1;
+    }
+
+    STAT_TIMER_STOP(output_time);
+
+    // Print where the run spent its time if requested
+    if (show_stats)
+        print_stats();
+
     return 0;   // Return 0 to indicate successful execution
 }
@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PROCESS 10  // Maximum number of processes entered interactively, a workload file may hold any number
+#define MAX_SLOTS 1000  // Maximum number of slots recorded in the Gantt chart
+#define STRIDE1 (1 << 20)  // Large constant divided by the tickets of a process to get its stride
+
+// Structure to represent Process
+typedef struct
+{
+    int process_id;        // Process ID (identifier)
+    int arrival_time;      // Time at which the process arrives in the ready queue
+    int burst_time;        // CPU burst time required by the process
+    int tickets;           // Number of tickets held by the process, its share of the CPU
+    int stride;            // Pass increment per quantum (STRIDE1 / tickets)
+    long long pass;        // Virtual time of the process, the process with the smallest pass runs next
+    int completion_time;   // Time at which the process finishes execution
+    int remaining_time;    // Remaining time for the process to execute
+} Process;
+
+// run_quantum, running the dispatched process for one quantum like round_robin_scheduling does
+#include "Quantum_Step.h"
+
+// Function to derive the turnaround time of a process from its completion time
+static inline int turn_around_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time;
+}
+
+// Function to derive the waiting time of a process from its completion time
+static inline int waiting_time(const Process *p)
+{
+    return p->completion_time - p->arrival_time - p->burst_time;
+}
+
+// Structure to represent Gantt chart
+typedef struct
+{
+    int process_id;
+    int time;
+}G;
+
+G gantt_chart[MAX_SLOTS]; // Array of Gantt chart
+Process *processes; // Array of processes, allocated for MAX_PROCESS or for the processes of the workload file
+int I = 0;  // Gantt chart tracker index
+int n, q;  // Number of processes and time quantum (slice of time given to each dispatched process)
+
+// Reader of the --workload files, the third column holds the tickets of each process
+#define WORKLOAD_PRIORITY_FIELD tickets
+#include "Workload_Reader.h"
+
+int *heap;              // Ready queue as a binary min-heap of process indices, ordered by pass
+int heap_size = 0;      // Number of processes in the ready queue
+long long global_pass = 0;  // Pass of the most recently dispatched process, new arrivals join relative to it
+
+// Function to allocate the processes and the ready queue for count processes
+// Returns -1 if the memory is not available
+int allocate_processes(int count)
+{
+    processes = malloc(count * sizeof(Process));
+    heap = malloc(count * sizeof(int));
+
+    return (processes == NULL || heap == NULL) ? -1 : 0;
+}
+
+// Function to read a workload file of any size, allocating the arrays for its processes
+// Returns the number of processes, -1 on error
+int load_large_workload(const char *path)
+{
+    long long count = count_workload_records(path);
+
+    if (count < 1 || count > __INT_MAX__ || allocate_processes((int)count) == -1)
+        return -1;
+
+    n = read_workload(path, (int)count, store_process);
+    return n;
+}
+
+// Function to check whether process a must run before process b: smaller pass first, then earlier arrival
+int runs_before(int a, int b)
+{
+    if (processes[a].pass != processes[b].pass)
+        return processes[a].pass < processes[b].pass;
+
+    return a < b;
+}
+
+// Function to add a process to the ready queue
+void heap_push(int process)
+{
+    int i = heap_size++;
+
+    // Move the new process up until its parent runs before it
+    while (i > 0 && runs_before(process, heap[(i - 1) / 2]))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    heap[i] = process;
+}
+
+// Function to remove and return the process with the smallest pass from the ready queue
+int heap_pop()
+{
+    int top = heap[0], last = heap[--heap_size], i = 0;
+
+    // Move the last process down from the root until both children run after it
+    while (2 * i + 1 < heap_size)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < heap_size && runs_before(heap[child + 1], heap[child]))
+            child++;
+
+        if (!runs_before(heap[child], last))
+            break;
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = last;
+    return top;
+}
+
+// Function to compare two processes for qsort by arrival time, equal arrivals keep their input order
+int compare_arrival(const void *a, const void *b)
+{
+    const Process *x = a, *y = b;
+
+    if (x->arrival_time != y->arrival_time)
+        return (x->arrival_time > y->arrival_time) - (x->arrival_time < y->arrival_time);
+
+    return (x->process_id > y->process_id) - (x->process_id < y->process_id);
+}
+
+// Function to add a slot to the Gantt chart, extending the last slot if the same process continues
+void add_gantt_slot(int process_id, int time)
+{
+    if (I > 0 && gantt_chart[I-1].process_id == process_id)
+    {
+        gantt_chart[I-1].time = time;
+    }
+    else if (I < MAX_SLOTS)
+    {
+        gantt_chart[I].process_id = process_id;
+        gantt_chart[I].time = time;
+        I++;
+    }
+}
+
+// Function to perform Stride Scheduling and calculate the completion time, turnaround time and waiting time
+// Every quantum goes to the process with the smallest pass, whose pass then advances by its stride, so each
+// process gets the CPU in proportion to its tickets, deterministically
+void stride_scheduling()
+{
+    int current_time = 0, completed_processes = 0, next_arrival = 0;
+
+    // Initialize remaining time for each process
+    for (int i = 0; i < n; i++)
+    {
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].completion_time = -1;
+        processes[i].stride = STRIDE1 / processes[i].tickets;
+    }
+
+    // Sort the processes based on their arrival time, in O(n log n) so that large workloads stay fast
+    qsort(processes, n, sizeof(Process), compare_arrival);
+
+    while (completed_processes < n)
+    {
+        // Move every process that has arrived into the ready queue, one stride after the current global pass
+        while (next_arrival < n && processes[next_arrival].arrival_time <= current_time)
+        {
+            processes[next_arrival].pass = global_pass + processes[next_arrival].stride;
+            heap_push(next_arrival++);
+        }
+
+        // If no process is ready, the CPU is idle until the next arrival
+        if (heap_size == 0)
+        {
+            current_time = processes[next_arrival].arrival_time;
+            add_gantt_slot(-1, current_time);
+            continue;
+        }
+
+        int next_process = heap_pop();
+        global_pass = processes[next_process].pass;
+
+        // Run the process for one quantum, or less if it finishes earlier
+        if (run_quantum(&processes[next_process], &current_time, q))
+        {
+            completed_processes++;
+        }
+        else
+        {
+            // Advance the pass of the process and put it back into the ready queue
+            processes[next_process].pass += processes[next_process].stride;
+            heap_push(next_process);
+        }
+
+        add_gantt_slot(processes[next_process].process_id, current_time);
+    }
+}
+
+// Function to calculate the average turnaround time
+float calculate_average_turnaround_time()
+{
+    long long total_turnaround_time = 0;  // Variable to store total turnaround time
+
+    // Calculate the sum of all turnaround times
+    for (int i = 0; i < n; i++)
+        total_turnaround_time += turn_around_time(&processes[i]);
+
+    return (float)total_turnaround_time / n;    // Return the average turnaround time
+}
+
+// Function to calculate the average waiting time
+float calculate_average_waiting_time()
+{
+    long long total_waiting_time = 0; // Variable to store total waiting time
+
+    // Calculate the sum of all waiting times
+    for (int i = 0; i < n; i++)
+        total_waiting_time += waiting_time(&processes[i]);
+
+    return (float)total_waiting_time / n;   // Return the average waiting time
+}
+
+// Function to print the Gantt Chart (graphical representation of process execution)
+void print_gantt_chart()
+{
+    printf("\nGantt Chart:\n ");
+
+    // Print the top row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    printf("\n|");
+
+    // Print the process IDs in the Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        if (gantt_chart[i].process_id == -1)
+        {
+            printf("\t|");
+        }
+        else
+        {
+            printf("  P%d   |", gantt_chart[i].process_id);
+        }
+    }
+
+    printf("\n ");
+
+    // Print the middle row (dashes) for Gantt chart
+    for (int i = 0; i < I; i++)
+    {
+        printf("--------");
+    }
+
+    // Print the completion times in the Gantt chart
+    printf("\n0");
+    for (int i = 0; i < I; i++)
+    {
+        printf("\t%d", gantt_chart[i].time);
+    }
+    printf("\n");
+
+    if (I == MAX_SLOTS)
+        printf("(Gantt chart truncated after %d slots)\n", MAX_SLOTS);
+}
+
+// Function to print the resultant table (showing process details)
+void print_resultant_table()
+{
+    printf("\nResultant Table:\n");
+
+    // Print the table header with column names
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+    printf("|  Process ID   |     A . T     |     B . T     |     C . T     |   T . A . T   |     W . T     |    Tickets    |\n");
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+
+    // Print process information for each process
+    for (int i = 0; i < n; i++)
+        printf("|\tP%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\t%d\t|\n",
+            processes[i].process_id,
+            processes[i].arrival_time,
+            processes[i].burst_time,
+            processes[i].completion_time,
+            turn_around_time(&processes[i]),
+            waiting_time(&processes[i]),
+            processes[i].tickets
+        );
+
+    printf("-----------------------------------------------------------------------------------------------------------------\n");
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    const char *workload_path = NULL;   // Workload file to read instead of the interactive input, if requested
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--workload") == 0)
+        {
+            workload_path = argv[++i];
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Read the workload from a file if requested, otherwise input it interactively
+    if (workload_path != NULL)
+    {
+        if (load_large_workload(workload_path) == -1)
+        {
+            printf("Could not read a workload of at least one process from %s.\n", workload_path);
+            return 1;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (processes[i].tickets <= 0 || processes[i].tickets > STRIDE1)
+            {
+                printf("Number of tickets must be between 1 and %d.\n", STRIDE1);
+                return 1;
+            }
+        }
+
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        if (q <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+    }
+    else
+    {
+        if (allocate_processes(MAX_PROCESS) == -1)
+        {
+            printf("Could not allocate the processes.\n");
+            return 1;
+        }
+
+        // Input the number of processes and the quantum number from the user
+        printf("Enter the number of processes: ");
+        scanf("%d", &n);
+
+        // Ensure that the number of processes is within the allowed limit
+        if (n < 1 || n > MAX_PROCESS)
+        {
+            printf("Number of processes must be between 1 and %d.\n", MAX_PROCESS);
+            return 1;
+        }
+
+        printf("Enter the quantum number: ");
+        scanf("%d", &q);
+
+        if (q <= 0)
+        {
+            printf("Quantum must be positive.\n");
+            return 1;
+        }
+
+        // Input the arrival time, burst time and tickets for each process
+        for (int i = 0; i < n; i++)
+        {
+            processes[i].process_id = i + 1;
+            printf("Enter the arrival time of P%d: ", i + 1);
+            scanf("%d", &processes[i].arrival_time);
+            printf("Enter the burst time of P%d: ", i + 1);
+            scanf("%d", &processes[i].burst_time);
+            printf("Enter the number of tickets of P%d: ", i + 1);
+            scanf("%d", &processes[i].tickets);
+
+            if (processes[i].tickets <= 0 || processes[i].tickets > STRIDE1)
+            {
+                printf("Number of tickets must be between 1 and %d.\n", STRIDE1);
+                return 1;
+            }
+        }
+    }
+
+    stride_scheduling();    // Perform the Stride Scheduling algorithm and calculate completion time, turnaround time, and waiting time for each process
+
+    // A workload file may hold millions of processes, so only the averages are printed for it
+    if (workload_path == NULL)
+    {
+        print_gantt_chart();        // Print the Gantt chart
+
+        print_resultant_table();    // Print the resultant table with process details
+    }
+
+    // Print the average turnaround time and waiting time
+    printf("\nAverage Turnaround Time: %.2f\n", calculate_average_turnaround_time());
+    printf("Average Waiting Time: %.2f\n", calculate_average_waiting_time());
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,161 @@
+// Windowed telemetry shared by the scheduling programs
+//
+// Before including this header, the including file provides MAX_PROCESS, the process array processes with an
+// arrival_time field, and the process count n. The engines report busy periods and completions through
+// telemetry_busy and telemetry_completion, which return at once when telemetry is off, and the program writes
+// the last window with end_telemetry. Every recorded event costs O(1) plus the number of window boundaries it crosses.
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdio.h>
+
+// Structure to hold the windowed telemetry of a run, filled incrementally while the engine runs
+typedef struct
+{
+    FILE *file;                 // File the windows are written to, NULL when telemetry is off
+    int width;                  // Width of a window in units of time
+    int window_start;           // Start of the current window
+    int last_time;              // Time up to which the current window has been accumulated
+    int in_system;              // Processes that have arrived but not completed
+    int max_in_system;          // Largest value of in_system during the current window
+    long long system_area;      // Integral of in_system over the current window
+    int busy_time;              // Time the CPU was busy during the current window
+    int completions;            // Processes completed during the current window
+    int arrivals[MAX_PROCESS];  // Arrival times in increasing order
+    int next_arrival;           // Index of the next arrival not yet counted
+} Telemetry;
+
+static Telemetry telemetry;    // Telemetry of the current run
+
+// Function to write the current window and start the next one
+static void write_telemetry_window(int window_end)
+{
+    int length = window_end - telemetry.window_start;
+    double utilization = (double)telemetry.busy_time / length;
+    double average_in_system = (double)telemetry.system_area / length;
+
+    // The ready queue holds every process in the system except the running one
+    fprintf(telemetry.file, "%d,%d,%.4f,%d,%.4f,%.4f,%.4f,%d\n",
+        telemetry.window_start, window_end, utilization, telemetry.completions, (double)telemetry.completions / length,
+        average_in_system, average_in_system - utilization, telemetry.max_in_system);
+
+    telemetry.window_start = window_end;
+    telemetry.last_time = window_end;
+    telemetry.max_in_system = telemetry.in_system;
+    telemetry.system_area = 0;
+    telemetry.busy_time = 0;
+    telemetry.completions = 0;
+}
+
+// Function to move the telemetry clock forward, writing every window that closes on the way
+static void advance_telemetry(int time)
+{
+    while (time >= telemetry.window_start + telemetry.width)
+    {
+        telemetry.system_area += (long long)telemetry.in_system * (telemetry.window_start + telemetry.width - telemetry.last_time);
+        write_telemetry_window(telemetry.window_start + telemetry.width);
+    }
+
+    telemetry.system_area += (long long)telemetry.in_system * (time - telemetry.last_time);
+    telemetry.last_time = time;
+}
+
+// Function to move the telemetry clock to the time of an event, counting the arrivals up to that time
+static void telemetry_event(int time)
+{
+    while (telemetry.next_arrival < n && telemetry.arrivals[telemetry.next_arrival] <= time)
+    {
+        advance_telemetry(telemetry.arrivals[telemetry.next_arrival++]);
+        telemetry.in_system++;
+
+        if (telemetry.in_system > telemetry.max_in_system)
+            telemetry.max_in_system = telemetry.in_system;
+    }
+
+    advance_telemetry(time);
+}
+
+// Function to start the telemetry of a run, returns 0 on success and -1 if the file cannot be opened
+static int begin_telemetry(const char *path, int width)
+{
+    telemetry.file = fopen(path, "w");
+
+    if (telemetry.file == NULL)
+        return -1;
+
+    telemetry.width = width;
+
+    // Keep the arrival times in increasing order using insertion sort, the engines may reorder the processes themselves
+    for (int i = 0; i < n; i++)
+    {
+        int j = i;
+
+        while (j > 0 && telemetry.arrivals[j - 1] > processes[i].arrival_time)
+        {
+            telemetry.arrivals[j] = telemetry.arrivals[j - 1];
+            j--;
+        }
+        telemetry.arrivals[j] = processes[i].arrival_time;
+    }
+
+    // Windows start at time 0, or at the first arrival if it is negative
+    telemetry.window_start = (n > 0 && telemetry.arrivals[0] < 0) ? telemetry.arrivals[0] : 0;
+    telemetry.last_time = telemetry.window_start;
+
+    fprintf(telemetry.file, "window_start,window_end,utilization,completions,throughput,average_in_system,average_ready_queue,max_in_system\n");
+    return 0;
+}
+
+// Function to record that the CPU was busy from start to end
+static void telemetry_busy(int start, int end)
+{
+    if (telemetry.file == NULL)
+        return;
+
+    // Split the busy period at window boundaries so each window gets its own share
+    while (start < end)
+    {
+        telemetry_event(start);
+
+        int part_end = (end < telemetry.window_start + telemetry.width) ? end : telemetry.window_start + telemetry.width;
+        telemetry.busy_time += part_end - start;
+        start = part_end;
+    }
+}
+
+// Function to record that a process completed at the given time
+static void telemetry_completion(int time)
+{
+    if (telemetry.file == NULL)
+        return;
+
+    telemetry_event(time);
+    telemetry.in_system--;
+    telemetry.completions++;
+}
+
+// Function to write the last, possibly partial, window and close the telemetry file
+// Returns 0 on success and -1 if a window could not be written
+static int end_telemetry()
+{
+    if (telemetry.file == NULL)
+        return 0;
+
+    // A run that ends exactly on a window boundary leaves its last completions in a window of length 0, which is
+    // written with its full width so they are not lost
+    if (telemetry.last_time > telemetry.window_start)
+        write_telemetry_window(telemetry.last_time);
+    else if (telemetry.completions > 0 || telemetry.busy_time > 0)
+        write_telemetry_window(telemetry.window_start + telemetry.width);
+
+    int failed = ferror(telemetry.file);
+
+    if (fclose(telemetry.file) == EOF)
+        failed = 1;
+    telemetry.file = NULL;
+
+    return failed ? -1 : 0;
+}
+
+#endif
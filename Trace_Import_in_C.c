@@ -0,0 +1,565 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TASKS 65536  // Maximum number of tasks that are awake or running at the same time, a power of two
+#define MAX_LINE 4096    // Maximum length of a trace line
+#define RECORD_FIELDS 3  // Fields of a workload record: arrival time, burst time and priority
+#define BLOCK_RECORDS 4096  // Number of records in a full block of a compressed workload
+#define MAX_VARINT_BYTES 5  // Longest varint encoding of a 32-bit value
+#define WORKLOAD_MAGIC 0x895A4C57u  // First word of a compressed workload file, no raw workload starts with it
+
+// Structure to represent a task seen in the trace while it has an open job
+typedef struct
+{
+    int pid;                  // Process ID of the task, 0 marks a free slot
+    int priority;             // Kernel priority of the task (lower is more important)
+    long long arrival;        // Time of the wakeup that opened the current job, in microseconds
+    long long burst;          // CPU time used by the current job so far, in microseconds
+    long long running_since;  // Time at which the task was last switched in, -1 while it is not running
+    int heap_index;           // Position of the task in open_heap
+} Task;
+
+// Structure to represent a finished job waiting until every earlier arrival has been written
+typedef struct
+{
+    long long arrival;        // Time of the wakeup that opened the job, in microseconds
+    long long burst;          // CPU time used by the job, in microseconds
+    long long sequence;       // Order in which the jobs finished, which breaks ties between equal arrivals
+    int priority;             // Kernel priority of the task
+} Job;
+
+// Structure of the header at the start of a compressed workload file
+typedef struct
+{
+    unsigned int magic;                 // WORKLOAD_MAGIC
+    unsigned int block_records;         // Maximum number of records in a block
+    unsigned int block_count;           // Number of blocks following the header
+    unsigned int reserved;              // Always 0
+    unsigned long long record_count;    // Number of records in all blocks
+    unsigned long long index_offset;    // File offset of the block index, one 64-bit file offset per block
+} Workload_Header;
+
+// Structure of the header in front of every block of a compressed workload
+// The payload holds per record the zigzag varint of the arrival time minus the previous one in the block (the first
+// one minus first_arrival), the varint of the burst time and the zigzag varint of the priority
+typedef struct
+{
+    unsigned int record_count;  // Number of records in the block
+    unsigned int payload_bytes; // Size of the encoded records following the header
+    int first_arrival;          // Arrival time the deltas of the block start from
+} Block_Header;
+
+Task tasks[MAX_TASKS];    // Open-addressing hash table of the tasks with an open job, keyed by pid
+int live_tasks = 0;       // Number of occupied slots in the table
+int open_heap[MAX_TASKS]; // Slots of the tasks with an open job, a binary min-heap by arrival time
+
+// The records are written in arrival order: a finished job waits in this min-heap by arrival time until no open job
+// arrived before it, since a job still open may end later but has to be written first
+Job *finished_jobs = NULL;          // Binary min-heap of the finished jobs not yet written
+long long finished_count = 0;       // Number of jobs in the heap
+long long finished_capacity = 0;    // Number of jobs the heap has room for
+long long finished_sequence = 0;    // Number of jobs that have finished so far
+
+FILE *output;             // Binary workload being written
+long long origin = -1;    // Timestamp of the first event, arrival times are relative to it
+long long unit = 1000;    // Length of one unit of time of the workload in microseconds
+int jobs_written = 0;     // Number of workload records written
+
+int compressed = 0;       // Set when the workload is written in the compressed block format
+unsigned char block_payload[BLOCK_RECORDS * RECORD_FIELDS * MAX_VARINT_BYTES];  // Encoded records of the current block
+Block_Header block = { 0, 0, 0 };   // Header of the current block
+int previous_arrival;     // Arrival time of the previous record in the current block
+unsigned long long *block_offsets = NULL;   // File offset of every block written, for the index
+unsigned int block_capacity = 0;            // Number of offsets block_offsets has room for
+Workload_Header header = { WORKLOAD_MAGIC, BLOCK_RECORDS, 0, 0, 0, 0 };  // Header of the compressed workload
+
+// Function to move the open task at a heap position up or down until the heap is ordered by arrival time again
+void fix_open_heap(int i)
+{
+    int slot = open_heap[i];
+
+    // Move it up while it arrived before its parent
+    while (i > 0 && tasks[slot].arrival < tasks[open_heap[(i - 1) / 2]].arrival)
+    {
+        open_heap[i] = open_heap[(i - 1) / 2];
+        tasks[open_heap[i]].heap_index = i;
+        i = (i - 1) / 2;
+    }
+
+    // Move it down while a child arrived before it
+    while (2 * i + 1 < live_tasks)
+    {
+        int child = 2 * i + 1;
+
+        if (child + 1 < live_tasks && tasks[open_heap[child + 1]].arrival < tasks[open_heap[child]].arrival)
+            child++;
+
+        if (tasks[open_heap[child]].arrival >= tasks[slot].arrival)
+            break;
+
+        open_heap[i] = open_heap[child];
+        tasks[open_heap[i]].heap_index = i;
+        i = child;
+    }
+
+    open_heap[i] = slot;
+    tasks[slot].heap_index = i;
+}
+
+// Function to find the slot of a task, or the free slot where it belongs
+int find_slot(int pid)
+{
+    int slot = (int)(((unsigned int)pid * 2654435761u) & (MAX_TASKS - 1));
+
+    while (tasks[slot].pid != 0 && tasks[slot].pid != pid)
+        slot = (slot + 1) & (MAX_TASKS - 1);
+
+    return slot;
+}
+
+// Function to return the task with an open job for a pid, opening one that arrives at time t if there is none
+Task *open_task(int pid, long long t)
+{
+    int slot = find_slot(pid);
+
+    if (tasks[slot].pid == 0)
+    {
+        // Keep one slot free so that every probe ends
+        if (live_tasks == MAX_TASKS - 1)
+        {
+            printf("More than %d tasks are awake at the same time.\n", MAX_TASKS - 1);
+            exit(1);
+        }
+
+        tasks[slot].pid = pid;
+        tasks[slot].priority = 0;
+        tasks[slot].arrival = t;
+        tasks[slot].burst = 0;
+        tasks[slot].running_since = -1;
+        open_heap[live_tasks] = slot;
+        tasks[slot].heap_index = live_tasks;
+        live_tasks++;
+        fix_open_heap(tasks[slot].heap_index);
+    }
+
+    return &tasks[slot];
+}
+
+// Function to free the slot of a task, moving later entries of the probe sequence back so no tombstones are needed
+void close_task(Task *task)
+{
+    int hole = (int)(task - tasks), slot = hole;
+
+    // Replace the task in the open heap by the last one
+    int i = task->heap_index;
+
+    live_tasks--;
+    if (i < live_tasks)
+    {
+        open_heap[i] = open_heap[live_tasks];
+        fix_open_heap(i);
+    }
+
+    task->pid = 0;
+
+    for (;;)
+    {
+        slot = (slot + 1) & (MAX_TASKS - 1);
+        if (tasks[slot].pid == 0)
+            break;
+
+        // An entry may fill the hole only if its home slot does not lie between the hole and itself
+        int home = (int)(((unsigned int)tasks[slot].pid * 2654435761u) & (MAX_TASKS - 1));
+        if (((slot - home) & (MAX_TASKS - 1)) >= ((slot - hole) & (MAX_TASKS - 1)))
+        {
+            tasks[hole] = tasks[slot];
+            open_heap[tasks[hole].heap_index] = hole;
+            tasks[slot].pid = 0;
+            hole = slot;
+        }
+    }
+}
+
+// Function to append a varint (7 bits per byte, lowest group first, high bit set on all but the last byte) to the block
+void put_varint(unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        block_payload[block.payload_bytes++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+
+    block_payload[block.payload_bytes++] = (unsigned char)value;
+}
+
+// Function to write the current block with its header and remember where it starts, returns -1 on error
+int flush_block()
+{
+    if (block.record_count == 0)
+        return 0;
+
+    // Grow the index by doubling, it holds one offset per block only
+    if (header.block_count == block_capacity)
+    {
+        unsigned int capacity = (block_capacity == 0) ? 1024 : 2 * block_capacity;
+        unsigned long long *offsets = realloc(block_offsets, capacity * sizeof(unsigned long long));
+
+        if (offsets == NULL)
+            return -1;
+
+        block_offsets = offsets;
+        block_capacity = capacity;
+    }
+
+    block_offsets[header.block_count++] = (unsigned long long)ftell(output);
+    header.record_count += block.record_count;
+
+    if (fwrite(&block, sizeof(block), 1, output) != 1 || fwrite(block_payload, 1, block.payload_bytes, output) != block.payload_bytes)
+        return -1;
+
+    block.record_count = block.payload_bytes = 0;
+    return 0;
+}
+
+// Function to write a workload record, as native 32-bit integers or into the current compressed block
+void emit_record(const int record[RECORD_FIELDS])
+{
+    if (!compressed)
+    {
+        fwrite(record, sizeof(int), RECORD_FIELDS, output);
+        return;
+    }
+
+    // Every block starts from an absolute arrival time, so each can be decoded without the ones before it
+    if (block.record_count == 0)
+        block.first_arrival = previous_arrival = record[0];
+
+    int delta = record[0] - previous_arrival;
+    previous_arrival = record[0];
+
+    // Zigzag encoding keeps small negative deltas and priorities short
+    put_varint(((unsigned int)delta << 1) ^ (unsigned int)(delta >> 31));
+    put_varint((unsigned int)record[1]);
+    put_varint(((unsigned int)record[2] << 1) ^ (unsigned int)(record[2] >> 31));
+
+    if (++block.record_count == BLOCK_RECORDS && flush_block() == -1)
+    {
+        printf("Could not write the workload.\n");
+        exit(1);
+    }
+}
+
+// Function to finish a compressed workload: write the last block, the block index and the final header
+int finish_compressed()
+{
+    if (flush_block() == -1)
+        return -1;
+
+    header.index_offset = (unsigned long long)ftell(output);
+
+    if (fwrite(block_offsets, sizeof(unsigned long long), header.block_count, output) != header.block_count
+        || fseek(output, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, output) != 1)
+        return -1;
+
+    free(block_offsets);
+    return 0;
+}
+
+// Function to check whether finished job a has to be written before finished job b
+int job_before(const Job *a, const Job *b)
+{
+    if (a->arrival != b->arrival)
+        return a->arrival < b->arrival;
+
+    return a->sequence < b->sequence;
+}
+
+// Function to put the current job of a task into the heap of finished jobs
+void finish_job(Task *task)
+{
+    if (task->burst <= 0)
+        return;
+
+    // Grow the heap by doubling, it only holds the jobs waiting for an earlier arrival to finish
+    if (finished_count == finished_capacity)
+    {
+        long long capacity = (finished_capacity == 0) ? 1024 : 2 * finished_capacity;
+        Job *jobs = realloc(finished_jobs, capacity * sizeof(Job));
+
+        if (jobs == NULL)
+        {
+            printf("Could not hold the finished jobs in memory.\n");
+            exit(1);
+        }
+
+        finished_jobs = jobs;
+        finished_capacity = capacity;
+    }
+
+    Job job = { task->arrival, task->burst, finished_sequence++, task->priority };
+    long long i = finished_count++;
+
+    // Move the new job up until its parent is written before it
+    while (i > 0 && job_before(&job, &finished_jobs[(i - 1) / 2]))
+    {
+        finished_jobs[i] = finished_jobs[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    finished_jobs[i] = job;
+}
+
+// Function to write the finished jobs that no open job arrived before, in arrival order, or all of them at the end
+void release_jobs(int all)
+{
+    while (finished_count > 0 && (all || live_tasks == 0 || finished_jobs[0].arrival <= tasks[open_heap[0]].arrival))
+    {
+        Job job = finished_jobs[0], last = finished_jobs[--finished_count];
+        long long i = 0;
+        int record[RECORD_FIELDS];
+
+        // Move the last job down from the root until both children are written after it
+        while (2 * i + 1 < finished_count)
+        {
+            long long child = 2 * i + 1;
+
+            if (child + 1 < finished_count && job_before(&finished_jobs[child + 1], &finished_jobs[child]))
+                child++;
+
+            if (!job_before(&finished_jobs[child], &last))
+                break;
+
+            finished_jobs[i] = finished_jobs[child];
+            i = child;
+        }
+        finished_jobs[i] = last;
+
+        record[0] = (int)((job.arrival - origin) / unit);
+        record[1] = (int)((job.burst + unit - 1) / unit);   // Round up so that every job needs at least one unit
+        record[2] = job.priority;
+
+        emit_record(record);
+        jobs_written++;
+    }
+}
+
+// Function to read the integer that follows a key such as "prev_pid=" in a line, returns -1 if the key is missing
+long long field(const char *line, const char *key)
+{
+    const char *value = strstr(line, key);
+    return (value == NULL) ? -1 : strtoll(value + strlen(key), NULL, 10);
+}
+
+// Function to parse the timestamp that ends just before the event name, "seconds.fraction:", in microseconds
+long long timestamp(const char *line, const char *event)
+{
+    const char *end = event;
+
+    // Skip back over the separator and an optional "sched:" prefix of perf script output
+    while (end > line && (end[-1] == ' ' || end[-1] == ':'))
+        end--;
+    if (end - line >= 5 && strncmp(end - 5, "sched", 5) == 0)
+    {
+        end -= 5;
+        while (end > line && (end[-1] == ' ' || end[-1] == ':'))
+            end--;
+    }
+
+    const char *start = end;
+    while (start > line && (start[-1] == '.' || (start[-1] >= '0' && start[-1] <= '9')))
+        start--;
+
+    if (start == end)
+        return -1;
+
+    // Take the seconds and the first six digits of the fraction
+    long long seconds = strtoll(start, NULL, 10), micros = 0;
+    const char *dot = memchr(start, '.', end - start);
+    int digits = 0;
+
+    if (dot != NULL)
+        for (const char *c = dot + 1; c < end && digits < 6; c++, digits++)
+            micros = micros * 10 + (*c - '0');
+
+    for (; digits < 6; digits++)
+        micros *= 10;
+
+    return seconds * 1000000 + micros;
+}
+
+// Function to account a sched_switch event: the previous task stops running and the next one starts
+void sched_switch(const char *line, long long t)
+{
+    int prev_pid = (int)field(line, "prev_pid="), next_pid = (int)field(line, "next_pid=");
+    const char *prev_state = strstr(line, "prev_state=");
+
+    // The idle task (pid 0) never forms a job
+    if (prev_pid > 0)
+    {
+        int slot = find_slot(prev_pid);
+
+        if (tasks[slot].pid == prev_pid)
+        {
+            Task *task = &tasks[slot];
+
+            if (task->running_since != -1)
+                task->burst += t - task->running_since;
+            task->running_since = -1;
+
+            // A task switched out in state R was pre-empted and stays ready, any other state ends its burst
+            if (prev_state != NULL && prev_state[11] != 'R')
+            {
+                finish_job(task);
+                close_task(task);
+                release_jobs(0);
+            }
+        }
+    }
+
+    if (next_pid > 0)
+    {
+        // A task that was already ready when the trace started arrives when it is first switched in
+        Task *task = open_task(next_pid, t);
+        long long priority = field(line, "next_prio=");
+
+        if (priority >= 0)
+            task->priority = (int)priority;
+        task->running_since = t;
+    }
+}
+
+// Function to account a sched_wakeup event: the task becomes ready, which opens a new job
+void sched_wakeup(const char *event, long long t)
+{
+    int pid = (int)field(event, " pid=");
+    long long priority = field(event, " prio=");
+
+    if (pid <= 0)
+        return;
+
+    Task *task = open_task(pid, t);
+
+    if (priority >= 0)
+        task->priority = (int)priority;
+}
+
+// Main function: Entry point of the program
+int main(int argc, char *argv[])
+{
+    const char *trace_path = NULL;      // Recorded scheduler trace in text form
+    const char *output_path = NULL;     // Binary workload to write
+    char line[MAX_LINE];
+    long long last_time = 0;            // Timestamp of the latest event
+    int events = 0, skipped = 0;        // Number of scheduler events used and of other lines
+
+    // Parse the command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--trace") == 0)
+        {
+            trace_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--binary") == 0)
+        {
+            output_path = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--compressed") == 0)
+        {
+            output_path = argv[++i];
+            compressed = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--unit") == 0)
+        {
+            unit = atoll(argv[++i]);
+        }
+        else
+        {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (trace_path == NULL || output_path == NULL || unit <= 0)
+    {
+        printf("Usage: %s --trace FILE --binary FILE | --compressed FILE [--unit MICROSECONDS]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *trace = fopen(trace_path, "r");
+    if (trace == NULL)
+    {
+        printf("Could not read the trace from %s.\n", trace_path);
+        return 1;
+    }
+
+    output = fopen(output_path, "wb");
+    if (output == NULL)
+    {
+        printf("Could not write the workload to %s.\n", output_path);
+        fclose(trace);
+        return 1;
+    }
+
+    // The header of a compressed workload is written again with the final counts at the end
+    if (compressed)
+        fwrite(&header, sizeof(header), 1, output);
+
+    // Stream the trace once, only the tasks with an open job are kept in memory
+    while (fgets(line, sizeof(line), trace) != NULL)
+    {
+        const char *event = strstr(line, "sched_switch:");
+        int is_switch = (event != NULL);
+
+        if (!is_switch && (event = strstr(line, "sched_wakeup")) == NULL)
+        {
+            skipped++;
+            continue;
+        }
+
+        long long t = timestamp(line, event);
+        if (t == -1)
+        {
+            skipped++;
+            continue;
+        }
+
+        if (origin == -1)
+            origin = t;
+        last_time = t;
+        events++;
+
+        if (is_switch)
+            sched_switch(event, t);
+        else
+            sched_wakeup(event, t);
+    }
+
+    // Jobs still open at the end of the trace are cut off there
+    for (int slot = 0; slot < MAX_TASKS; slot++)
+    {
+        if (tasks[slot].pid != 0)
+        {
+            if (tasks[slot].running_since != -1)
+                tasks[slot].burst += last_time - tasks[slot].running_since;
+            finish_job(&tasks[slot]);
+        }
+    }
+
+    release_jobs(1);
+    free(finished_jobs);
+
+    fclose(trace);
+
+    int failed = (compressed && finish_compressed() == -1);
+
+    if (fclose(output) != 0 || failed)
+    {
+        printf("Could not write the workload to %s.\n", output_path);
+        return 1;
+    }
+
+    printf("Imported %d processes from %d scheduler events (%d other lines skipped).\n", jobs_written, events, skipped);
+
+    return 0;   // Return 0 to indicate successful execution
+}
@@ -0,0 +1,214 @@
+// Reader of the workload files written by Trace_Import_in_C.c, shared by the scheduling programs
+//
+// Before including this header, the including file provides MAX_PROCESS, the process array processes and the
+// process count n. Define PROCESS_HAS_PRIORITY if the process structure has a priority field to fill, or
+// WORKLOAD_PRIORITY_FIELD as the field that takes the third column instead (a deadline or a number of tickets),
+// otherwise the priority stored in the file is skipped. read_workload passes the records to any other destination,
+// or to store_process for a process array allocated for a workload of any size.
+
+#ifndef WORKLOAD_READER_H
+#define WORKLOAD_READER_H
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#define WORKLOAD_MAGIC 0x895A4C57u  // First word of a compressed workload file, no raw workload starts with it
+#define MAX_BLOCK_RECORDS 65536  // Largest block of a compressed workload that can be decoded
+
+// Structure of the header at the start of a compressed workload file written by Trace_Import_in_C.c
+typedef struct
+{
+    unsigned int magic;                 // WORKLOAD_MAGIC
+    unsigned int block_records;         // Maximum number of records in a block
+    unsigned int block_count;           // Number of blocks following the header
+    unsigned int reserved;              // Always 0
+    unsigned long long record_count;    // Number of records in all blocks
+    unsigned long long index_offset;    // File offset of the block index, one 64-bit file offset per block
+} Workload_Header;
+
+// Structure of the header in front of every block of a compressed workload
+typedef struct
+{
+    unsigned int record_count;  // Number of records in the block
+    unsigned int payload_bytes; // Size of the encoded records following the header
+    int first_arrival;          // Arrival time the deltas of the block start from
+} Block_Header;
+
+#define ZIGZAG_DECODE(value) ((int)((value) >> 1) ^ -(int)((value) & 1))  // Undo the zigzag mapping of signed values
+
+static unsigned char block_payload[MAX_BLOCK_RECORDS * 3 * 5];  // Encoded records of one block, at most 5 bytes per value
+
+// Function to decode a varint (7 bits per byte, lowest group first), returns -1 if the block ends inside it
+static int read_varint(const unsigned char **position, const unsigned char *end, unsigned int *value)
+{
+    unsigned int result = 0;
+
+    for (int shift = 0; *position < end && shift < 35; shift += 7)
+    {
+        unsigned char byte = *(*position)++;
+        result |= (unsigned int)(byte & 0x7f) << shift;
+
+        if (!(byte & 0x80))
+        {
+            *value = result;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+// Function to store record index of a workload file in the process array, the default destination of load_workload
+static void store_process(int index, int arrival_time, int burst_time, int priority)
+{
+    processes[index].process_id = index + 1;
+    processes[index].arrival_time = arrival_time;
+    processes[index].burst_time = burst_time;
+#if defined(WORKLOAD_PRIORITY_FIELD)
+    processes[index].WORKLOAD_PRIORITY_FIELD = priority;
+#elif defined(PROCESS_HAS_PRIORITY)
+    processes[index].priority = priority;
+#else
+    (void)priority;
+#endif
+}
+
+// Function called for every record read from a workload file, with its index, arrival time, burst time and priority
+typedef void (*Workload_Store)(int index, int arrival_time, int burst_time, int priority);
+
+static int record_buffer[4096][3];  // Raw records read from the file at once
+
+// Function to read a compressed workload block by block: per record the zigzag varint of the arrival time minus the
+// previous one, the varint of the burst time and the zigzag varint of the priority. Only one block is held at a time
+static int read_compressed_workload(int fd, int capacity, Workload_Store store)
+{
+    Workload_Header header;
+    Block_Header block;
+    int count = 0;
+
+    if (read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) || header.record_count > (unsigned long long)capacity)
+        return -1;
+
+    for (unsigned int b = 0; b < header.block_count; b++)
+    {
+        if (read(fd, &block, sizeof(block)) != (ssize_t)sizeof(block) || block.record_count > MAX_BLOCK_RECORDS
+            || block.payload_bytes > sizeof(block_payload) || block.record_count > (unsigned int)(capacity - count)
+            || read(fd, block_payload, block.payload_bytes) != (ssize_t)block.payload_bytes)
+            return -1;
+
+        const unsigned char *position = block_payload, *end = block_payload + block.payload_bytes;
+        int arrival = block.first_arrival;
+
+        for (unsigned int r = 0; r < block.record_count; r++)
+        {
+            unsigned int delta, burst, priority;
+
+            if (read_varint(&position, end, &delta) == -1 || read_varint(&position, end, &burst) == -1
+                || read_varint(&position, end, &priority) == -1)
+                return -1;
+
+            arrival += ZIGZAG_DECODE(delta);
+            store(count++, arrival, (int)burst, ZIGZAG_DECODE(priority));
+        }
+    }
+
+    // A file cut short after its header holds fewer records than announced
+    return ((unsigned long long)count == header.record_count) ? count : -1;
+}
+
+// Function to read a workload file written by Trace_Import_in_C.c, compressed or raw records of three native 32-bit
+// integers (arrival time, burst time, priority), passing every record to store in file order
+// Returns the number of records, -1 on error, if the file ends inside a record or holds more than capacity records
+static int read_workload(const char *path, int capacity, Workload_Store store)
+{
+    int fd = open(path, O_RDONLY), count = 0;
+    unsigned int magic;
+
+    if (fd == -1)
+        return -1;
+
+    // A compressed workload is recognized by its first word, raw records never start with it
+    if (read(fd, &magic, sizeof(magic)) == (ssize_t)sizeof(magic) && magic == WORKLOAD_MAGIC)
+    {
+        lseek(fd, 0, SEEK_SET);
+        int result = read_compressed_workload(fd, capacity, store);
+        close(fd);
+        return result;
+    }
+
+    // Read the raw records a buffer at a time, keeping a record split between two reads for the next one
+    lseek(fd, 0, SEEK_SET);
+    size_t filled = 0;
+    ssize_t got;
+
+    while ((got = read(fd, (char *)record_buffer + filled, sizeof(record_buffer) - filled)) > 0)
+    {
+        filled += got;
+        size_t records = filled / sizeof(record_buffer[0]);
+
+        for (size_t r = 0; r < records; r++)
+        {
+            // The workload must fit in the destination
+            if (count == capacity)
+            {
+                close(fd);
+                return -1;
+            }
+
+            store(count++, record_buffer[r][0], record_buffer[r][1], record_buffer[r][2]);
+        }
+
+        filled -= records * sizeof(record_buffer[0]);
+        memmove(record_buffer, record_buffer[records], filled);
+    }
+
+    close(fd);
+
+    // A record left incomplete at the end means the file was cut short, so none of it is trusted
+    return (got == -1 || filled != 0) ? -1 : count;
+}
+
+// Function to count the records of a workload file without decoding them
+// Returns -1 if the file cannot be read or a raw file ends inside a record
+static inline long long count_workload_records(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    Workload_Header header;
+    long long count = -1;
+
+    if (fd == -1)
+        return -1;
+
+    if (read(fd, &header, sizeof(header.magic)) == (ssize_t)sizeof(header.magic) && header.magic == WORKLOAD_MAGIC)
+    {
+        if (read(fd, (char *)&header + sizeof(header.magic), sizeof(header) - sizeof(header.magic))
+            == (ssize_t)(sizeof(header) - sizeof(header.magic)))
+            count = (long long)header.record_count;
+    }
+    else
+    {
+        off_t size = lseek(fd, 0, SEEK_END);
+
+        if (size != -1 && size % (off_t)sizeof(record_buffer[0]) == 0)
+            count = size / (long long)sizeof(record_buffer[0]);
+    }
+
+    close(fd);
+    return count;
+}
+
+// Function to read the workload from a file into the process array, returns the number of processes, -1 on error
+// Like the interactive input, the workload must hold at least one process
+static inline int load_workload(const char *path)
+{
+    int count = read_workload(path, MAX_PROCESS, store_process);
+
+    if (count < 1)
+        return -1;
+
+    n = count;
+    return count;
+}
+
+#endif